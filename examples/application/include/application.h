@@ -21,6 +21,11 @@ struct Application
     bool Close();
     void Quit();
 
+    // In idle mode frames are drawn only on input, when requested or once per wait timeout
+    void SetIdleMode(bool enable, float waitTimeout = 0.5f);
+    void RequestFrame(); // draw next frame without waiting, call from OnFrame() while something animates
+    void RequestFrame(float delay); // draw frame at most after delay seconds, call from OnFrame() for things due later
+
     const std::string& GetName() const;
 
     ImFont* DefaultFont() const;
@@ -52,6 +57,10 @@ private:
     ImGuiContext*               m_Context = nullptr;
     ImFont*                     m_DefaultFont = nullptr;
     ImFont*                     m_HeaderFont = nullptr;
+    bool                        m_IdleMode = false;
+    float                       m_IdleWaitTimeout = 0.5f;
+    float                       m_RequestedWaitTimeout = -1.0f;
+    int                         m_PendingFrames = 0;
 };
 
 int Main(int argc, char** argv);
\ No newline at end of file
@@ -2,6 +2,8 @@
 # include "setup.h"
 # include "platform.h"
 # include "renderer.h"
+# include <chrono>
+# include <cstring>
 
 extern "C" {
 #define STB_IMAGE_IMPLEMENTATION
@@ -9,6 +11,8 @@ extern "C" {
 #include "stb_image.h"
 }
 
+static const int c_IdleSettleFrames = 2;
+
 
 Application::Application(const char* name)
     : Application(name, 0, nullptr)
@@ -17,9 +21,24 @@ Application::Application(const char* name)
 
 Application::Application(const char* name, int argc, char** argv)
     : m_Name(name)
-    , m_Platform(CreatePlatform(*this))
-    , m_Renderer(CreateRenderer())
 {
+    // Run without window and GPU, see platform_headless.cpp for options
+    bool headless = false;
+    for (int i = 1; i < argc; ++i)
+        if (strcmp(argv[i], "--headless") == 0)
+            headless = true;
+
+    if (headless)
+    {
+        m_Platform = CreateHeadlessPlatform(*this);
+        m_Renderer = CreateHeadlessRenderer();
+    }
+    else
+    {
+        m_Platform = CreatePlatform(*this);
+        m_Renderer = CreateRenderer();
+    }
+
     m_Platform->ApplicationStart(argc, argv);
 }
 
@@ -72,11 +91,30 @@ int Application::Run()
 {
     m_Platform->ShowMainWindow();
 
-    while (m_Platform->ProcessMainWindowEvents())
+    while (true)
     {
+        const bool  wait        = m_IdleMode && m_PendingFrames == 0;
+        const auto  waitStart   = std::chrono::steady_clock::now();
+        auto        waitTimeout = m_IdleWaitTimeout;
+        if (m_RequestedWaitTimeout >= 0.0f && m_RequestedWaitTimeout < waitTimeout)
+            waitTimeout = m_RequestedWaitTimeout;
+        m_RequestedWaitTimeout = -1.0f;
+
+        if (!m_Platform->ProcessMainWindowEvents(wait ? waitTimeout : 0.0f))
+            break;
+
         if (!m_Platform->IsMainWindowVisible())
             continue;
 
+        if (m_PendingFrames > 0)
+            --m_PendingFrames;
+
+        // Woken up before timeout, so there was input. ImGui needs few
+        // more frames to settle hover state, popups and layout after it.
+        const auto waitTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - waitStart).count();
+        if (wait && waitTime < waitTimeout)
+            m_PendingFrames = c_IdleSettleFrames;
+
         Frame();
     }
 
@@ -168,6 +206,26 @@ void Application::Frame()
     m_Platform->FinishFrame();
 }
 
+void Application::SetIdleMode(bool enable, float waitTimeout /*= 0.5f*/)
+{
+    m_IdleMode        = enable;
+    m_IdleWaitTimeout = waitTimeout;
+}
+
+void Application::RequestFrame()
+{
+    if (m_PendingFrames < 1)
+        m_PendingFrames = 1;
+}
+
+void Application::RequestFrame(float delay)
+{
+    if (delay <= 0.0f)
+        RequestFrame();
+    else if (m_RequestedWaitTimeout < 0.0f || delay < m_RequestedWaitTimeout)
+        m_RequestedWaitTimeout = delay;
+}
+
 void Application::SetTitle(const char* title)
 {
     m_Platform->SetMainWindowTitle(title);
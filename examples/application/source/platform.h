@@ -17,7 +17,7 @@ struct Platform
     virtual void* GetMainWindowHandle() const = 0;
     virtual void SetMainWindowTitle(const char* title) = 0;
     virtual void ShowMainWindow() = 0;
-    virtual bool ProcessMainWindowEvents() = 0;
+    virtual bool ProcessMainWindowEvents(float waitTimeout) = 0; // waits up to waitTimeout seconds for first event, 0 only polls
     virtual bool IsMainWindowVisible() const = 0;
 
     virtual void SetRenderer(Renderer* renderer) = 0;
@@ -58,3 +58,4 @@ private:
 };
 
 std::unique_ptr<Platform> CreatePlatform(Application& application);
+std::unique_ptr<Platform> CreateHeadlessPlatform(Application& application);
@@ -30,7 +30,7 @@ struct PlatformGLFW final
     void* GetMainWindowHandle() const override;
     void SetMainWindowTitle(const char* title) override;
     void ShowMainWindow() override;
-    bool ProcessMainWindowEvents() override;
+    bool ProcessMainWindowEvents(float waitTimeout) override;
     bool IsMainWindowVisible() const override;
     void SetRenderer(Renderer* renderer) override;
     void NewFrame() override;
@@ -201,13 +201,15 @@ void PlatformGLFW::ShowMainWindow()
     glfwShowWindow(m_Window);
 }
 
-bool PlatformGLFW::ProcessMainWindowEvents()
+bool PlatformGLFW::ProcessMainWindowEvents(float waitTimeout)
 {
     if (m_Window == nullptr)
         return false;
 
     if (m_IsMinimized)
         glfwWaitEvents();
+    else if (waitTimeout > 0.0f)
+        glfwWaitEventsTimeout(waitTimeout);
     else
         glfwPollEvents();
 
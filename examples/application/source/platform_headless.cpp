@@ -0,0 +1,221 @@
+# include "platform.h"
+# include "setup.h"
+# include "application.h"
+# include "renderer.h"
+
+# include <imgui.h>
+# include <chrono>
+# include <cmath>
+# include <cstdio>
+# include <cstdlib>
+# include <cstring>
+
+// Platform without window system. Main window is a fixed size virtual
+// surface, input is generated from frame number so every run is the same
+// and time advances by fixed step. Runs for given number of frames.
+//
+// Options:
+//   --frames <n>         frames to run before quitting (default: 600)
+//   --size <w>x<h>       virtual window size (default: 1440x800)
+//   --no-input           do not generate mouse input
+struct PlatformHeadless final
+    : Platform
+{
+    PlatformHeadless(Application& application);
+
+    bool ApplicationStart(int argc, char** argv) override;
+    void ApplicationStop() override;
+    bool OpenMainWindow(const char* title, int width, int height) override;
+    bool CloseMainWindow() override;
+    void* GetMainWindowHandle() const override;
+    void SetMainWindowTitle(const char* title) override;
+    void ShowMainWindow() override;
+    bool ProcessMainWindowEvents(float waitTimeout) override;
+    bool IsMainWindowVisible() const override;
+    void SetRenderer(Renderer* renderer) override;
+    void NewFrame() override;
+    void FinishFrame() override;
+    void Quit() override;
+
+    void GenerateInput(ImGuiIO& io);
+
+    using Clock = std::chrono::steady_clock;
+
+    Application&    m_Application;
+    Renderer*       m_Renderer = nullptr;
+    bool            m_IsOpen = false;
+    bool            m_QuitRequested = false;
+    bool            m_GenerateInput = true;
+    int             m_Width = -1;
+    int             m_Height = -1;
+    int             m_FrameLimit = 600;
+    int             m_FrameCount = 0;
+    Clock::time_point m_FrameStart;
+    double          m_TotalFrameTime = 0.0;
+    double          m_MaxFrameTime = 0.0;
+};
+
+std::unique_ptr<Platform> CreateHeadlessPlatform(Application& application)
+{
+    return std::make_unique<PlatformHeadless>(application);
+}
+
+# if BACKEND(HEADLESS)
+std::unique_ptr<Platform> CreatePlatform(Application& application)
+{
+    return CreateHeadlessPlatform(application);
+}
+# endif
+
+PlatformHeadless::PlatformHeadless(Application& application)
+    : m_Application(application)
+{
+}
+
+bool PlatformHeadless::ApplicationStart(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (!std::strcmp(arg, "--frames") && i + 1 < argc)
+            m_FrameLimit = std::atoi(argv[++i]);
+        else if (!std::strcmp(arg, "--size") && i + 1 < argc)
+            std::sscanf(argv[++i], "%dx%d", &m_Width, &m_Height);
+        else if (!std::strcmp(arg, "--no-input"))
+            m_GenerateInput = false;
+    }
+
+    return true;
+}
+
+void PlatformHeadless::ApplicationStop()
+{
+    if (m_FrameCount == 0)
+        return;
+
+    std::printf("headless: %d frames at %dx%d, frame time %.3f ms avg, %.3f ms max\n",
+        m_FrameCount, m_Width, m_Height,
+        m_TotalFrameTime * 1000.0 / m_FrameCount, m_MaxFrameTime * 1000.0);
+}
+
+bool PlatformHeadless::OpenMainWindow(const char* /*title*/, int width, int height)
+{
+    if (m_IsOpen)
+        return false;
+
+    // Size from command line wins over one requested by application
+    if (m_Width <= 0 || m_Height <= 0)
+    {
+        m_Width  = width  < 0 ? 1440 : width;
+        m_Height = height < 0 ?  800 : height;
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "headless";
+
+    m_IsOpen = true;
+
+    return true;
+}
+
+bool PlatformHeadless::CloseMainWindow()
+{
+    if (!m_IsOpen)
+        return true;
+
+    auto canClose = m_Application.CanClose();
+    if (canClose)
+        m_QuitRequested = true;
+
+    return canClose;
+}
+
+void* PlatformHeadless::GetMainWindowHandle() const
+{
+    return nullptr;
+}
+
+void PlatformHeadless::SetMainWindowTitle(const char* /*title*/)
+{
+}
+
+void PlatformHeadless::ShowMainWindow()
+{
+}
+
+bool PlatformHeadless::ProcessMainWindowEvents(float /*waitTimeout*/)
+{
+    // Synthetic input is always there, never wait for it
+    if (!m_IsOpen)
+        return false;
+
+    if (m_QuitRequested || (m_FrameLimit > 0 && m_FrameCount >= m_FrameLimit))
+    {
+        m_IsOpen = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool PlatformHeadless::IsMainWindowVisible() const
+{
+    return m_IsOpen;
+}
+
+void PlatformHeadless::SetRenderer(Renderer* renderer)
+{
+    m_Renderer = renderer;
+
+    if (m_Renderer)
+        m_Renderer->Resize(m_Width, m_Height);
+}
+
+void PlatformHeadless::NewFrame()
+{
+    m_FrameStart = Clock::now();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(m_Width), static_cast<float>(m_Height));
+    io.DeltaTime   = 1.0f / 60.0f;
+
+    if (m_GenerateInput)
+        GenerateInput(io);
+}
+
+void PlatformHeadless::FinishFrame()
+{
+    if (m_Renderer)
+        m_Renderer->Present();
+
+    const double frameTime = std::chrono::duration<double>(Clock::now() - m_FrameStart).count();
+    m_TotalFrameTime += frameTime;
+    if (m_MaxFrameTime < frameTime)
+        m_MaxFrameTime = frameTime;
+
+    ++m_FrameCount;
+}
+
+void PlatformHeadless::Quit()
+{
+    m_QuitRequested = true;
+}
+
+void PlatformHeadless::GenerateInput(ImGuiIO& io)
+{
+    // Mouse wanders over whole window, in every 240 frames it drags for
+    // a while and scrolls once each way
+    const int   frame = m_FrameCount;
+    const int   cycle = frame % 240;
+    const float t     = frame * 0.02f;
+
+    io.MousePos.x = m_Width  * (0.5f + 0.45f * std::sin(t * 1.3f));
+    io.MousePos.y = m_Height * (0.5f + 0.45f * std::sin(t * 1.7f + 0.5f));
+
+    io.MouseDown[0] = cycle >= 60 && cycle < 90;
+
+    if (cycle == 150)
+        io.MouseWheel = 1.0f;
+    else if (cycle == 210)
+        io.MouseWheel = -1.0f;
+}
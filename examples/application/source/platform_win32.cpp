@@ -46,7 +46,7 @@ struct PlatformWin32 final
     void* GetMainWindowHandle() const override;
     void SetMainWindowTitle(const char* title) override;
     void ShowMainWindow() override;
-    bool ProcessMainWindowEvents() override;
+    bool ProcessMainWindowEvents(float waitTimeout) override;
     bool IsMainWindowVisible() const override;
     void SetRenderer(Renderer* renderer) override;
     void NewFrame() override;
@@ -189,11 +189,14 @@ void PlatformWin32::ShowMainWindow()
     UpdateWindow(m_MainWindowHandle);
 }
 
-bool PlatformWin32::ProcessMainWindowEvents()
+bool PlatformWin32::ProcessMainWindowEvents(float waitTimeout)
 {
     if (m_MainWindowHandle == nullptr)
         return false;
 
+    if (!m_IsMinimized && waitTimeout > 0.0f)
+        MsgWaitForMultipleObjects(0, nullptr, FALSE, static_cast<DWORD>(waitTimeout * 1000.0f), QS_ALLINPUT);
+
     auto fetchMessage = [this](MSG* msg) -> bool
     {
         if (!m_IsMinimized)
@@ -30,3 +30,4 @@ struct Renderer
 };
 
 std::unique_ptr<Renderer> CreateRenderer();
+std::unique_ptr<Renderer> CreateHeadlessRenderer();
@@ -0,0 +1,189 @@
+# include "renderer.h"
+# include "platform.h"
+
+# include <imgui.h>
+# include <algorithm>
+# include <cstdio>
+
+// Null renderer, draws nothing. Consumes draw data and reports how much
+// of it there was, so draw data size can be tracked without GPU.
+struct RendererHeadless final
+    : Renderer
+{
+    struct Texture
+    {
+        int Width  = 0;
+        int Height = 0;
+    };
+
+    bool Create(Platform& platform) override;
+    void Destroy() override;
+    void NewFrame() override;
+    void RenderDrawData(ImDrawData* drawData) override;
+    void Clear(const ImVec4& color) override;
+    void Present() override;
+    void Resize(int width, int height) override;
+
+    ImVector<Texture*>::iterator FindTexture(ImTextureID texture);
+    ImTextureID CreateTexture(const void* data, int width, int height) override;
+    void        DestroyTexture(ImTextureID texture) override;
+    int         GetTextureWidth(ImTextureID texture) override;
+    int         GetTextureHeight(ImTextureID texture) override;
+
+    Platform*           m_Platform = nullptr;
+    ImVector<Texture*>  m_Textures;
+    ImTextureID         m_FontTexture = nullptr;
+
+    int                 m_FrameCount = 0;
+    long long           m_TotalVertexCount = 0;
+    long long           m_TotalIndexCount = 0;
+    long long           m_TotalDrawCallCount = 0;
+    int                 m_MaxVertexCount = 0;
+    int                 m_MaxIndexCount = 0;
+    int                 m_MaxDrawCallCount = 0;
+};
+
+std::unique_ptr<Renderer> CreateHeadlessRenderer()
+{
+    return std::make_unique<RendererHeadless>();
+}
+
+# if RENDERER(HEADLESS)
+std::unique_ptr<Renderer> CreateRenderer()
+{
+    return CreateHeadlessRenderer();
+}
+# endif
+
+bool RendererHeadless::Create(Platform& platform)
+{
+    m_Platform = &platform;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    m_Platform->SetRenderer(this);
+
+    return true;
+}
+
+void RendererHeadless::Destroy()
+{
+    if (!m_Platform)
+        return;
+
+    m_Platform->SetRenderer(nullptr);
+
+    for (auto texture : m_Textures)
+        delete texture;
+    m_Textures.clear();
+    m_FontTexture = nullptr;
+
+    if (m_FrameCount == 0)
+        return;
+
+    std::printf("null renderer: %d frames, per frame avg %.0f vertices, %.0f indices, %.1f draw calls, max %d vertices, %d indices, %d draw calls\n",
+        m_FrameCount,
+        static_cast<double>(m_TotalVertexCount)   / m_FrameCount,
+        static_cast<double>(m_TotalIndexCount)    / m_FrameCount,
+        static_cast<double>(m_TotalDrawCallCount) / m_FrameCount,
+        m_MaxVertexCount, m_MaxIndexCount, m_MaxDrawCallCount);
+}
+
+void RendererHeadless::NewFrame()
+{
+    // Application replaces font atlas when scale changes, pick up new one
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.Fonts->TexID && io.Fonts->TexID == m_FontTexture)
+        return;
+
+    if (m_FontTexture)
+        DestroyTexture(m_FontTexture);
+
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    m_FontTexture = CreateTexture(pixels, width, height);
+    io.Fonts->SetTexID(m_FontTexture);
+}
+
+void RendererHeadless::RenderDrawData(ImDrawData* drawData)
+{
+    if (!drawData || !drawData->Valid)
+        return;
+
+    int drawCallCount = 0;
+    for (int i = 0; i < drawData->CmdListsCount; ++i)
+    {
+        for (auto& command : drawData->CmdLists[i]->CmdBuffer)
+        {
+            if (!command.UserCallback && command.ElemCount > 0)
+                ++drawCallCount;
+        }
+    }
+
+    ++m_FrameCount;
+    m_TotalVertexCount   += drawData->TotalVtxCount;
+    m_TotalIndexCount    += drawData->TotalIdxCount;
+    m_TotalDrawCallCount += drawCallCount;
+    m_MaxVertexCount      = std::max(m_MaxVertexCount,   drawData->TotalVtxCount);
+    m_MaxIndexCount       = std::max(m_MaxIndexCount,    drawData->TotalIdxCount);
+    m_MaxDrawCallCount    = std::max(m_MaxDrawCallCount, drawCallCount);
+}
+
+void RendererHeadless::Clear(const ImVec4& /*color*/)
+{
+}
+
+void RendererHeadless::Present()
+{
+}
+
+void RendererHeadless::Resize(int /*width*/, int /*height*/)
+{
+}
+
+ImTextureID RendererHeadless::CreateTexture(const void* /*data*/, int width, int height)
+{
+    auto texture = new Texture();
+    texture->Width  = width;
+    texture->Height = height;
+
+    m_Textures.push_back(texture);
+
+    return texture;
+}
+
+ImVector<RendererHeadless::Texture*>::iterator RendererHeadless::FindTexture(ImTextureID texture)
+{
+    return std::find(m_Textures.begin(), m_Textures.end(), static_cast<Texture*>(texture));
+}
+
+void RendererHeadless::DestroyTexture(ImTextureID texture)
+{
+    auto textureIt = FindTexture(texture);
+    if (textureIt == m_Textures.end())
+        return;
+
+    delete *textureIt;
+
+    m_Textures.erase(textureIt);
+}
+
+int RendererHeadless::GetTextureWidth(ImTextureID texture)
+{
+    auto textureIt = FindTexture(texture);
+    if (textureIt != m_Textures.end())
+        return (*textureIt)->Width;
+    return 0;
+}
+
+int RendererHeadless::GetTextureHeight(ImTextureID texture)
+{
+    auto textureIt = FindTexture(texture);
+    if (textureIt != m_Textures.end())
+        return (*textureIt)->Height;
+    return 0;
+}
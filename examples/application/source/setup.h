@@ -33,7 +33,7 @@
 
 
 // Define BACKEND(x) which evaluate to 0 or 1 when
-// 'x' is: IMGUI_WIN32 or IMGUI_GLFW
+// 'x' is: IMGUI_WIN32, IMGUI_GLFW or HEADLESS
 //
 // Use BACKEND_CONFIG to override desired backend
 //
@@ -50,9 +50,11 @@
 # ifndef BACKEND_HAVE_IMGUI_GLFW
 #     define BACKEND_HAVE_IMGUI_GLFW()         0
 # endif
+# define BACKEND_HAVE_HEADLESS()               1
 
 # define BACKEND_PRIV_IMGUI_WIN32()            1
 # define BACKEND_PRIV_IMGUI_GLFW()             2
+# define BACKEND_PRIV_HEADLESS()               3
 
 # if !defined(BACKEND_CONFIG)
 #     if PLATFORM(WINDOWS)
@@ -66,7 +68,7 @@
 
 
 // Define RENDERER(x) which evaluate to 0 or 1 when
-// 'x' is: IMGUI_DX11 or IMGUI_OGL3
+// 'x' is: IMGUI_DX11, IMGUI_OGL3 or HEADLESS
 //
 // Use RENDERER_CONFIG to override desired renderer
 //
@@ -83,9 +85,11 @@
 # ifndef RENDERER_HAVE_IMGUI_OGL3
 #     define RENDERER_HAVE_IMGUI_OGL3()         0
 # endif
+# define RENDERER_HAVE_HEADLESS()               1
 
 # define RENDERER_PRIV_IMGUI_DX11()             1
 # define RENDERER_PRIV_IMGUI_OGL3()             2
+# define RENDERER_PRIV_HEADLESS()               3
 
 # if !defined(RENDERER_CONFIG)
 #     if PLATFORM(WINDOWS)
@@ -0,0 +1,674 @@
+#include "AbilityGraph.h"
+#include "AbilityWriter.h"
+#include "AbilityTokenizer.h"
+#include <cctype>
+#include <algorithm>
+#include <unordered_map>
+
+
+void AbilityGraph::Clear()
+{
+    // Nodes and pins are trivially destructible, dropping the blocks frees them all
+    Nodes.clear();
+    Pins.clear();
+    m_Links.clear();
+    root_nodes.clear();
+    m_PinById.clear();
+    m_NodeById.clear();
+    Blocks.clear();
+
+    LooseBlock.Root = nullptr;
+    LooseBlock.Nodes.clear();
+    LooseBlock.Pins.clear();
+    LooseBlock.Links.clear();
+    LooseBlock.Arena.Reset();
+
+    uniqueId = 1;
+    m_NextLinkId = 100;
+}
+
+float AbilityGraph::LayoutSubtree(Node* node, int depth, float& yCursor,
+    std::unordered_set<Node*>& visited)
+{
+    // Internal node whose children are being laid out. Kept on an explicit
+    // stack so deeply nested abilities do not exhaust the call stack.
+    struct LayoutFrame
+    {
+        Node*  node;
+        int    depth;
+        size_t nextChild;       // next index into node->OutputNodes
+        float  subtreeStartY;
+        float  totalRows;
+    };
+
+    std::vector<LayoutFrame> stack;
+
+    // Place `n` if it is a leaf, otherwise push it. Returns rows used so far.
+    auto enter = [&](Node* n, int d) -> float
+        {
+            if (!n)
+                return 0.0f;
+
+            // Avoid infinite recursion on cycles
+            if (visited.count(n))
+                return 0.0f;
+            visited.insert(n);
+
+            bool hasChildren = false;
+            for (Node* c : n->OutputNodes)
+                if (c)
+                {
+                    hasChildren = true;
+                    break;
+                }
+
+            // Leaf node: just place it and advance y
+            if (!hasChildren)
+            {
+                n->Start_pos = ImVec2(d * LAYOUT_X_STEP, yCursor);
+                yCursor += LAYOUT_Y_STEP;
+                return 1.0f;
+            }
+
+            // Internal node: first layout children, then place node in the vertical middle
+            stack.push_back({ n, d, 0, yCursor, 0.0f });
+            return 0.0f;
+        };
+
+    float result = enter(node, depth);
+
+    while (!stack.empty())
+    {
+        const size_t top = stack.size() - 1;
+        Node* current = stack[top].node;
+
+        // Gather real children (skip nulls)
+        size_t i = stack[top].nextChild;
+        while (i < current->OutputNodes.size() && !current->OutputNodes[i])
+            ++i;
+
+        if (i < current->OutputNodes.size())
+        {
+            stack[top].nextChild = i + 1;
+            float rows = enter(current->OutputNodes[i], stack[top].depth + 1);
+            stack[top].totalRows += rows;
+            continue;
+        }
+
+        LayoutFrame frame = stack.back();
+        stack.pop_back();
+
+        if (frame.totalRows <= 0.0f)
+            frame.totalRows = 1.0f; // safety
+
+        float centerY = frame.subtreeStartY + (frame.totalRows * LAYOUT_Y_STEP) * 0.5f;
+        frame.node->Start_pos = ImVec2(frame.depth * LAYOUT_X_STEP, centerY);
+
+        if (stack.empty())
+            result = frame.totalRows;
+        else
+            stack.back().totalRows += frame.totalRows;
+    }
+
+    return result;
+}
+
+// Layout all graphs starting from root_nodes
+void AbilityGraph::AutoLayoutGraphs()
+{
+    std::unordered_set<Node*> visited;
+    float rootY = 0.0f;
+
+    for (Node* root : root_nodes)
+    {
+        if (!root)
+            continue;
+
+        float yCursor = rootY;
+        float rows = LayoutSubtree(root, /*depth=*/0, yCursor, visited);
+
+        // Leave some gap before the next root tree
+        rootY = yCursor + LAYOUT_ROOT_GAP;
+    }
+}
+
+Pin* AbilityGraph::FindPin(ed::PinId id) const
+{
+    const uintptr_t index = id.Get();
+    return index < m_PinById.size() ? m_PinById[index] : nullptr;
+}
+
+Node* AbilityGraph::FindNode(ed::NodeId id) const
+{
+    const uintptr_t index = id.Get();
+    return index < m_NodeById.size() ? m_NodeById[index] : nullptr;
+}
+
+void AbilityGraph::RemoveNode(Node* node)
+{
+    if (!node)
+        return;
+
+    m_PinById[node->InputPin->ID.Get()] = nullptr;
+    for (Pin* pin : node->OutputPins)
+        m_PinById[pin->ID.Get()] = nullptr;
+    m_NodeById[node->ID.Get()] = nullptr;
+
+    auto isNodePin = [node](Pin* pin) { return pin->NodePtr == node; };
+
+    Pins.erase(std::remove_if(Pins.begin(), Pins.end(), isNodePin), Pins.end());
+    Nodes.erase(std::remove(Nodes.begin(), Nodes.end(), node), Nodes.end());
+    root_nodes.erase(std::remove(root_nodes.begin(), root_nodes.end(), node), root_nodes.end());
+
+    AbilityBlock& block = *node->Block;
+    block.Pins.erase(std::remove_if(block.Pins.begin(), block.Pins.end(), isNodePin), block.Pins.end());
+    block.Nodes.erase(std::remove(block.Nodes.begin(), block.Nodes.end(), node), block.Nodes.end());
+    if (block.Root == node)
+        block.Root = nullptr;
+    block.Dirty = true;
+}
+
+void AbilityGraph::RenameNode(Node* node, const char* name)
+{
+    node->Name = node->Block->Arena.CopyString(name);
+    node->Block->Dirty = true;
+}
+
+void AbilityGraph::MarkDirty(Node* node)
+{
+    if (node)
+        node->Block->Dirty = true;
+}
+
+void AbilityGraph::ReleaseBlock(AbilityBlock& block)
+{
+    for (Pin* pin : block.Pins)
+        m_PinById[pin->ID.Get()] = nullptr;
+    for (Node* node : block.Nodes)
+        m_NodeById[node->ID.Get()] = nullptr;
+
+    block.Root = nullptr;
+    block.Nodes.clear();
+    block.Pins.clear();
+    block.Links.clear();
+    block.Diagnostics.clear();
+    block.Arena.Reset();
+}
+
+Pin* AbilityGraph::MakePin(PinType type, PinKind kind)
+{
+    AbilityBlock& block = m_BuildBlock ? *m_BuildBlock : LooseBlock;
+
+    const int id = uniqueId++;
+    auto* pin = block.Arena.New<Pin>(ed::PinId(id), type, kind);
+    block.Pins.push_back(pin);
+
+    // While parsing, the graph is collected from the blocks once they are built
+    if (!m_BuildBlock)
+        Pins.push_back(pin);
+
+    if (m_PinById.size() <= static_cast<size_t>(id))
+        m_PinById.resize(id + 1, nullptr);
+    m_PinById[id] = pin;
+
+    return pin;
+}
+
+Node* AbilityGraph::MakeBasicNode(std::string_view name,
+    PinType inputType,
+    const PinType* outputTypes, int outputCount,
+    ImVec2 startPos, const char* desc, NodeType nodetype)
+{
+    AbilityBlock& block = m_BuildBlock ? *m_BuildBlock : LooseBlock;
+
+    Pin* inputPin = MakePin(inputType, PinKind::Input);
+
+    ArenaArray<Pin*> outputs = block.Arena.NewArray<Pin*>(outputCount);
+    for (int i = 0; i < outputCount; ++i)
+        outputs[i] = MakePin(outputTypes[i], PinKind::Output);
+
+    ArenaArray<Node*> outputNodes = block.Arena.NewArray<Node*>(outputCount, nullptr);
+
+    const int id = uniqueId++;
+    auto* node = block.Arena.New<Node>(ed::NodeId(id), block.Arena.CopyString(name), inputPin, outputs, outputNodes, startPos, desc, nodetype);
+    node->Block = &block;
+    block.Nodes.push_back(node);
+
+    if (m_NodeById.size() <= static_cast<size_t>(id))
+        m_NodeById.resize(id + 1, nullptr);
+    m_NodeById[id] = node;
+
+    if (!m_BuildBlock)
+    {
+        Nodes.push_back(node);
+        if (nodetype == NodeType::Primary) { root_nodes.push_back(node); }
+    }
+    return node;
+}
+
+Node* AbilityGraph::MakeBasicNode(std::string_view name,
+    PinType inputType,
+    std::initializer_list<PinType> outputTypes,
+    ImVec2 startPos, const char* desc, NodeType nodetype)
+{
+    return MakeBasicNode(name, inputType, outputTypes.begin(), static_cast<int>(outputTypes.size()), startPos, desc, nodetype);
+}
+
+Node* AbilityGraph::NodeFromFunciton(const function& f, ImVec2 startPos)
+{
+    // struct only stores 10 outputs
+    int outputCount = f.output_size < 10 ? f.output_size : 10;
+
+    return MakeBasicNode(f.Name, f.input, f.output, outputCount, startPos, f.description);
+}
+
+void AbilityGraph::ParseNodes(std::string& text) const
+{
+    AbilityTextWriter writer;
+    ParseNodes(text, writer);
+}
+
+void AbilityGraph::ParseNodes(std::string& text, AbilityTextWriter& writer, unsigned jobs) const
+{
+    // If there are no root nodes, just append the message and return
+    if (root_nodes.empty())
+    {
+        if (!text.empty() && text.back() != '\n')
+            text += '\n';
+
+        text += "a root node is needed";
+        return;
+    }
+
+    writer.Build(*this);
+
+    // Room for the cycle note too, so the text is grown only once
+    text.reserve(text.size() + writer.Size(true) + 16);
+    writer.WriteParallel(text, jobs);
+
+    // If a cycle was detected anywhere, note it at the end of the string
+    if (writer.CycleDetected())
+        text += "cycle detected";
+}
+
+void AbilityGraph::BuildBlock(AbilityBlock& block, const std::vector<AbilityToken>& tokens, AbilityRange g)
+{
+    m_BuildBlock = &block;
+
+    // One node per token plus the root. Every output pin is filled by one of
+    // the following tokens, so there are about two pins per node.
+    const size_t nodeCount = g.size() + 1;
+    block.Nodes.reserve(nodeCount);
+    block.Pins.reserve(2 * nodeCount);
+    block.Links.reserve(g.size());
+    block.Arena.Reserve(nodeCount * (sizeof(Node) + 2 * sizeof(Pin) + 2 * sizeof(void*) + 16) + block.Source.size());
+
+    // Locations are stored relative to the block, see BlockDiagnostic
+    auto report = [&](std::string message, const AbilityToken* token)
+        {
+            BlockDiagnostic diagnostic;
+            diagnostic.Message = std::move(message);
+            if (token)
+            {
+                diagnostic.Line = token->Line - block.FirstLine;
+                diagnostic.Column = token->Column;
+            }
+            block.Diagnostics.push_back(std::move(diagnostic));
+        };
+
+    // a) Any function with this name (used when we don't care about overloads)
+    auto findFuncAny = [&](std::string_view name) -> const function*
+        {
+            return Catalog ? Catalog->FindAny(name) : nullptr;
+        };
+
+    // b) Overload-aware: pick function whose input matches `expected` if possible
+    auto findFunc = [&](std::string_view name, PinType expected) -> const function*
+        {
+            return Catalog ? Catalog->Find(name, expected) : nullptr;
+        };
+
+    // Expression parser
+    //
+    // Functions are parsed depth first in prefix order. Instead of recursing
+    // once per output pin, every function node still waiting for children
+    // sits on an explicit stack, so nesting depth is bounded only by memory.
+    struct PendingNode
+    {
+        Node*           node;   // function node waiting for its children
+        const function* f;      // its signature, f->output[pin] is what the next child must be
+        int             pin;    // output pin the next parsed expression connects to
+    };
+
+    std::vector<PendingNode> pending;
+
+    auto ParseExpr = [&](const AbilityRange& toks, size_t& idx, PinType expected) -> Node*
+        {
+            pending.clear();
+
+            for (;;)
+            {
+                // a) Parse a single token as an expression of type `expected`.
+                //    `done` is the finished subtree, nullptr if an error was reported.
+                Node* done = nullptr;
+
+                if (idx >= toks.End)
+                {
+                    std::string message = "error: unexpected end of input while expecting ";
+                    message += PinTypeToString(expected);
+                    report(std::move(message), nullptr);
+                }
+                else
+                {
+                    const AbilityToken& token = tokens[idx++];
+                    const std::string_view tok = token.Text;
+                    const function* f = findFunc(tok, expected);
+
+                    if (f)
+                    {
+                        //    Parent's output (expected) must flow into f->input.
+                        if (CanConnectPinTypes(/*inputType=*/f->input, /*outputType=*/expected))
+                        {
+                            Node* node = NodeFromFunciton(*f, ImVec2(0, 0));
+
+                            if (f->output_size > 0)
+                            {
+                                // Children follow in the token stream, parse the first one next
+                                pending.push_back({ node, f, 0 });
+                                expected = f->output[0];
+                                continue;
+                            }
+
+                            done = node;
+                        }
+
+                        // 2) Relaxed rule: if this function takes Trigger as input,
+                        //    and we couldn't connect it, treat token as a constant of `expected`.
+                        else if (f->input == PinType::Trigger)
+                        {
+                            done = MakeBasicNode(
+                                tok,
+                                expected,  // "matching constant of the previous type"
+                                {},
+                                ImVec2(0, 0),
+                                "",
+                                NodeType::Constant
+                            );
+                        }
+
+                        // 3) Genuine type mismatch
+                        else
+                        {
+                            std::string message = "error: type mismatch at token '";
+                            message += tok;
+                            message += "': function expects ";
+                            message += PinTypeToString(f->input);
+                            message += " but parent needed ";
+                            message += PinTypeToString(expected);
+                            report(std::move(message), &token);
+                        }
+                    }
+                    else
+                    {
+                        // No function with that name at all -> constant of expected type
+                        done = MakeBasicNode(tok, expected, {}, ImVec2(0, 0), "", NodeType::Constant);
+                    }
+                }
+
+                // b) Hand the finished subtree to the pending parents. A parent is
+                //    finished when its last pin is connected or when one of its
+                //    children failed; then it is handed to its own parent in turn.
+                for (;;)
+                {
+                    if (pending.empty())
+                        return done;
+
+                    PendingNode& parent = pending.back();
+
+                    if (!done)
+                    {
+                        // keep partial graph, error already reported
+                        done = parent.node;
+                        pending.pop_back();
+                        continue;
+                    }
+
+                    Node* node = parent.node;
+                    const int p = parent.pin;
+
+                    node->OutputNodes[p] = done;
+                    done->InputNode = node;
+
+                    block.Links.push_back({
+                        ed::LinkId(m_NextLinkId++),
+                        done->InputPin->ID,
+                        node->OutputPins[p]->ID
+                        });
+
+                    if (++parent.pin < parent.f->output_size)
+                    {
+                        expected = parent.f->output[parent.pin];
+                        break;
+                    }
+
+                    done = node;
+                    pending.pop_back();
+                }
+            }
+        };
+
+    // Parse the graph, create Primary Root
+    const std::string_view first = tokens[g.Begin].Text;
+
+    // Infer root output type from first token if possible
+    PinType rootOutputType = PinType::Trigger;
+    if (const function* f0 = findFuncAny(first))
+        rootOutputType = f0->input;
+
+    // Create primary root node
+    Node* root = MakeBasicNode(
+        "Root",
+        PinType::Action,         // dummy input
+        { rootOutputType },      // one output
+        ImVec2(0, 0),
+        "",
+        NodeType::Primary
+    );
+    block.Root = root;
+
+    size_t idx = g.Begin;
+    Node* child = ParseExpr(g, idx, rootOutputType);
+
+    if (child)
+    {
+        root->OutputNodes[0] = child;
+        child->InputNode = root;
+
+        block.Links.push_back({
+            ed::LinkId(m_NextLinkId++),
+            child->InputPin->ID,
+            root->OutputPins[0]->ID
+            });
+    }
+
+    if (idx < g.End)
+    {
+        std::string message = "warning: extra tokens at end of line starting with '";
+        message += first;
+        message += "'";
+        report(std::move(message), &tokens[idx]);
+    }
+
+    m_BuildBlock = nullptr;
+}
+
+ParseTextResult AbilityGraph::ParseText(std::string_view text, std::string& diagnostics)
+{
+    ParseTextResult result;
+
+    // 1) Tokenize in one pass; tokens are views into `text`
+    std::vector<AbilityToken> tokens;
+    tokens.reserve(text.size() / 8);
+    TokenizeAbilityText(text, tokens);
+
+    // 2) Group tokens into graphs, one per Root (or one for the whole text)
+    std::vector<AbilityRange> graphs;
+    SplitAbilities(tokens, graphs);
+
+    // 3) Match graphs with blocks of the previous parse. A block is kept if
+    //    its text (from the start of its first line, Root included, to the
+    //    end of its last token) is unchanged, so are the relative positions
+    //    stored in its diagnostics.
+    std::unordered_multimap<std::string_view, size_t> previous;
+    previous.reserve(Blocks.size());
+    for (size_t i = 0; i < Blocks.size(); ++i)
+        if (!Blocks[i]->Dirty)
+            previous.emplace(Blocks[i]->Source, i);
+
+    std::vector<std::unique_ptr<AbilityBlock>> blocks;
+    std::vector<AbilityRange>                  toBuild;     // ranges of blocks[i] that are new, empty if kept
+    blocks.reserve(graphs.size());
+    toBuild.reserve(graphs.size());
+
+    for (auto& g : graphs)
+    {
+        const AbilityToken& firstToken = tokens[g.First];
+        const AbilityToken& lastToken = tokens[g.End - 1];
+        const char* sourceBegin = firstToken.Text.data() - (firstToken.Column - 1);
+        const char* sourceEnd = lastToken.Text.data() + lastToken.Text.size();
+        const std::string_view source(sourceBegin, static_cast<size_t>(sourceEnd - sourceBegin));
+
+        std::unique_ptr<AbilityBlock> block;
+
+        auto candidates = previous.equal_range(source);
+        for (auto it = candidates.first; it != candidates.second; ++it)
+        {
+            if (Blocks[it->second])
+            {
+                block = std::move(Blocks[it->second]);
+                previous.erase(it);
+                break;
+            }
+        }
+
+        if (block)
+        {
+            toBuild.push_back({ 0, 0, 0 });
+            ++result.KeptBlocks;
+        }
+        else
+        {
+            block.reset(new AbilityBlock());
+            block->Source = std::string(source);
+            toBuild.push_back(g);
+            ++result.RebuiltBlocks;
+        }
+
+        block->FirstLine = firstToken.Line;
+        blocks.push_back(std::move(block));
+    }
+
+    // 4) Blocks left over were edited or deleted. Their roots are the places
+    //    rebuilt blocks go to, in order.
+    std::vector<ImVec2> anchors;
+    for (auto& block : Blocks)
+    {
+        if (!block)
+            continue;
+
+        if (block->Root)
+            anchors.push_back(block->Root->Start_pos);
+
+        ReleaseBlock(*block);
+    }
+    Blocks.clear();
+
+    // Nodes created by hand are not part of the text
+    ReleaseBlock(LooseBlock);
+
+    // Rebuilt blocks without an anchor go below everything that was kept
+    bool  hasKept = false;
+    float nextFreeY = 0.0f;
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        if (!toBuild[i].empty())
+            continue;
+
+        for (Node* node : blocks[i]->Nodes)
+        {
+            const float bottom = node->Start_pos.y + LAYOUT_Y_STEP + LAYOUT_ROOT_GAP;
+            if (!hasKept || bottom > nextFreeY)
+                nextFreeY = bottom;
+            hasKept = true;
+        }
+    }
+
+    // 5) Build new blocks in text order, then lay them out
+    size_t nextAnchor = 0;
+    std::unordered_set<Node*> visited;
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        if (toBuild[i].empty())
+            continue;
+
+        AbilityBlock& block = *blocks[i];
+        BuildBlock(block, tokens, toBuild[i]);
+
+        if (nextAnchor < anchors.size())
+        {
+            // Lay out in place of the replaced block: root where the old root was
+            float yCursor = 0.0f;
+            LayoutSubtree(block.Root, /*depth=*/0, yCursor, visited);
+
+            const ImVec2 anchor = anchors[nextAnchor++];
+            const float dx = anchor.x - block.Root->Start_pos.x;
+            const float dy = anchor.y - block.Root->Start_pos.y;
+            for (Node* node : block.Nodes)
+                node->Start_pos = ImVec2(node->Start_pos.x + dx, node->Start_pos.y + dy);
+        }
+        else
+        {
+            float yCursor = nextFreeY;
+            LayoutSubtree(block.Root, /*depth=*/0, yCursor, visited);
+
+            // Leave some gap before the next root tree
+            nextFreeY = yCursor + LAYOUT_ROOT_GAP;
+        }
+
+        result.CreatedNodes.insert(result.CreatedNodes.end(), block.Nodes.begin(), block.Nodes.end());
+    }
+
+    // 6) Collect the graph and diagnostics of all blocks in text order
+    Blocks = std::move(blocks);
+
+    Nodes.clear();
+    Pins.clear();
+    m_Links.clear();
+    root_nodes.clear();
+
+    for (auto& block : Blocks)
+    {
+        Nodes.insert(Nodes.end(), block->Nodes.begin(), block->Nodes.end());
+        Pins.insert(Pins.end(), block->Pins.begin(), block->Pins.end());
+        m_Links.insert(m_Links.end(), block->Links.begin(), block->Links.end());
+        if (block->Root)
+            root_nodes.push_back(block->Root);
+
+        for (auto& diagnostic : block->Diagnostics)
+        {
+            diagnostics += '\n';
+            diagnostics += diagnostic.Message;
+
+            if (diagnostic.Line >= 0)
+            {
+                diagnostics += " (line ";
+                diagnostics += std::to_string(block->FirstLine + diagnostic.Line);
+                diagnostics += ", column ";
+                diagnostics += std::to_string(diagnostic.Column);
+                diagnostics += ")";
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_set>
+#include <initializer_list>
+#include <memory>
+#include "Nodes.h"
+#include "FunctionCatalog.h"
+#include "AbilityTokenizer.h"
+
+class AbilityTextWriter;
+
+// AbilityGraph.h
+//
+// Text <-> graph conversion for CubeChaos abilities. Everything in here is
+// free of ImGui windows and ed:: editor calls so it can be driven from the
+// editor as well as from headless tools (see examples/chaosnode-cli).
+
+// Diagnostic of a block, Line is relative to the block's first line (-1 if
+// it has no location) so it stays valid when the block moves in the text.
+struct BlockDiagnostic
+{
+    std::string Message;
+    int         Line = -1;
+    int         Column = 0;
+};
+
+// Nodes built from one Root block of the text (or all of it in implicit
+// root mode). Each block owns its memory, so an edited block can be rebuilt
+// without touching the others.
+struct AbilityBlock
+{
+    std::string                  Source;        // text the block was built from
+    int                          FirstLine = 1; // line of Source in the current text
+    bool                         Dirty = false; // graph was edited by hand, rebuild on next parse
+    Node*                        Root = nullptr;
+    GraphArena                   Arena;
+    std::vector<Node*>           Nodes;
+    std::vector<Pin*>            Pins;
+    std::vector<LinkInfo>        Links;
+    std::vector<BlockDiagnostic> Diagnostics;
+};
+
+struct ParseTextResult
+{
+    std::vector<Node*> CreatedNodes;    // nodes of rebuilt blocks, everything else kept its position
+    int                KeptBlocks = 0;
+    int                RebuiltBlocks = 0;
+};
+
+struct AbilityGraph
+{
+    int uniqueId = 1;
+
+    std::vector<Node*> Nodes{};
+    std::vector<Pin*> Pins{};
+    std::vector<Node*> root_nodes{};
+
+    const FunctionCatalog* Catalog = nullptr;    // functions known to the parser, not owned
+
+    std::vector<LinkInfo> m_Links;                 // List of live links.
+    int                   m_NextLinkId = 100;      // Counter to help generate link ids.
+
+    const float LAYOUT_X_STEP = 230.0f;    // horizontal spacing between columns
+    const float LAYOUT_Y_STEP = 90.0f;     // vertical spacing between siblings
+    const float LAYOUT_ROOT_GAP = 120.0f;    // vertical gap between different root trees
+
+    // Every Node and Pin above belongs to one block: a parsed one in text
+    // order, or LooseBlock for nodes created by hand.
+    std::vector<std::unique_ptr<AbilityBlock>> Blocks;
+    AbilityBlock                               LooseBlock;
+    AbilityBlock*                              m_BuildBlock = nullptr;  // where Make* allocate, null = LooseBlock
+
+    // Ids come from uniqueId, so they index these tables directly. Slots of
+    // deleted objects and of ids used by the other kind are null. Ids are
+    // never handed out twice, the editor keeps its own state under them
+    // (size, pins, selection, settings), so the tables grow until Clear().
+    std::vector<Pin*>     m_PinById;
+    std::vector<Node*>    m_NodeById;
+
+    AbilityGraph() = default;
+    AbilityGraph(const AbilityGraph&) = delete;
+    AbilityGraph& operator=(const AbilityGraph&) = delete;
+
+    // Drop every node, pin and link and reset id counters. Node and Pin
+    // pointers from before are invalid afterwards.
+    void Clear();
+
+    Pin* FindPin(ed::PinId id) const;
+    Node* FindNode(ed::NodeId id) const;
+
+    // Unlink `node` and its pins from the graph. Memory stays in the arena
+    // until its block is rebuilt. Links are not touched.
+    void RemoveNode(Node* node);
+
+    // Replace the name of a constant node.
+    void RenameNode(Node* node, const char* name);
+
+    // Call when the graph of `node` is edited by hand (links, renames, ...).
+    // Its block no longer matches its text and is rebuilt on the next parse.
+    void MarkDirty(Node* node);
+
+    Pin* MakePin(PinType type, PinKind kind);
+
+    Node* MakeBasicNode(std::string_view name,
+        PinType inputType,
+        const PinType* outputTypes, int outputCount,
+        ImVec2 startPos, const char* desc = "", NodeType nodetype = NodeType::Basic);
+
+    Node* MakeBasicNode(std::string_view name,
+        PinType inputType,
+        std::initializer_list<PinType> outputTypes,
+        ImVec2 startPos, const char* desc = "", NodeType nodetype = NodeType::Basic);
+
+    Node* NodeFromFunciton(const function& f, ImVec2 startPos);
+
+    // Layout a subtree (children left to right, parent centered). Returns "height" in rows.
+    float LayoutSubtree(Node* node, int depth, float& yCursor,
+        std::unordered_set<Node*>& visited);
+
+    // Layout all graphs starting from root_nodes
+    void AutoLayoutGraphs();
+
+    // Graph -> text. Appends one line per root to `text`.
+    void ParseNodes(std::string& text) const;
+
+    // Same, reusing the buffers of `writer` and writing roots on up to
+    // `jobs` threads (see AbilityWriter.h).
+    void ParseNodes(std::string& text, AbilityTextWriter& writer, unsigned jobs = 1) const;
+
+    // Text -> graph. Errors and warnings are appended to `diagnostics` (one
+    // per line, each starting with '\n').
+    //
+    // Only Root blocks whose text changed (or that were edited by hand) are
+    // rebuilt; nodes, ids and Start_pos of the others are kept. Rebuilt
+    // blocks take the place of the block they replace, new ones go below
+    // everything else. Nodes created by hand are dropped.
+    ParseTextResult ParseText(std::string_view text, std::string& diagnostics);
+
+private:
+    void ReleaseBlock(AbilityBlock& block);
+    void BuildBlock(AbilityBlock& block, const std::vector<AbilityToken>& tokens, AbilityRange range);
+};
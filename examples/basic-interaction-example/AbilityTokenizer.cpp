@@ -0,0 +1,82 @@
+#include "AbilityTokenizer.h"
+#include <cctype>
+
+
+void TokenizeAbilityText(std::string_view text, std::vector<AbilityToken>& tokens)
+{
+    const char* const begin = text.data();
+    const char* const end = begin + text.size();
+
+    const char* p = begin;
+    const char* lineBegin = begin;
+    int line = 1;
+    bool lineStart = true;
+
+    while (p < end)
+    {
+        const char c = *p;
+
+        if (c == '\n')
+        {
+            ++p;
+            ++line;
+            lineBegin = p;
+            lineStart = true;
+            continue;
+        }
+
+        if (std::isspace(static_cast<unsigned char>(c)))
+        {
+            ++p;
+            continue;
+        }
+
+        const char* tokenBegin = p;
+        while (p < end && !std::isspace(static_cast<unsigned char>(*p)))
+            ++p;
+
+        tokens.push_back({
+            std::string_view(tokenBegin, static_cast<size_t>(p - tokenBegin)),
+            line,
+            static_cast<int>(tokenBegin - lineBegin) + 1,
+            lineStart
+            });
+
+        lineStart = false;
+    }
+}
+
+void SplitAbilities(const std::vector<AbilityToken>& tokens, std::vector<AbilityRange>& abilities)
+{
+    if (tokens.empty())
+        return;
+
+    // Explicit-root mode is decided by the first non-empty line
+    const bool explicitRootMode = tokens[0].Text == "Root";
+
+    if (!explicitRootMode)
+    {
+        // All text is one graph, newlines are just whitespace
+        abilities.push_back({ 0, tokens.size(), 0 });
+        return;
+    }
+
+    // Explicit-root mode: each line starting with Root begins a new graph
+    AbilityRange current = { 0, 0, 0 };
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        if (!tokens[i].LineStart || tokens[i].Text != "Root")
+            continue;
+
+        current.End = i;
+        if (!current.empty())
+            abilities.push_back(current);
+
+        // Drop the "Root" token itself, rest belong to this graph
+        current = { i + 1, i + 1, i };
+    }
+
+    current.End = tokens.size();
+    if (!current.empty())
+        abilities.push_back(current);
+}
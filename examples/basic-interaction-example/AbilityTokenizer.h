@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// AbilityTokenizer.h
+//
+// Single pass, allocation free (apart from the output vector) tokenizer for
+// ability text. Tokens are views into the caller's buffer, which has to stay
+// alive while they are used.
+
+struct AbilityToken
+{
+    std::string_view Text;
+    int              Line;          // 1-based
+    int              Column;        // 1-based, in bytes
+    bool             LineStart;     // first token on its line
+};
+
+// Ability = run of tokens parsed into one Root graph, as [Begin, End) into the token list.
+struct AbilityRange
+{
+    size_t Begin;
+    size_t End;
+    size_t First;       // first token of the ability's text, the "Root" keyword if there is one
+
+    bool   empty() const { return Begin == End; }
+    size_t size() const  { return End - Begin; }
+};
+
+// Split `text` on whitespace, appending to `tokens`.
+void TokenizeAbilityText(std::string_view text, std::vector<AbilityToken>& tokens);
+
+// Group tokens into abilities.
+//
+// If the first token of the text is "Root", every line starting with "Root"
+// begins a new ability (the keyword itself is dropped, empty abilities are
+// skipped). Otherwise the whole text is one ability and newlines are just
+// whitespace.
+void SplitAbilities(const std::vector<AbilityToken>& tokens, std::vector<AbilityRange>& abilities);
@@ -0,0 +1,207 @@
+#include "AbilityWriter.h"
+#include "AbilityGraph.h"
+#include <cstring>
+#include <thread>
+
+
+// Per node walk state, indexed by node id
+enum : uint8_t
+{
+    c_Unvisited = 0,
+    c_OnStack   = 1,    // on the path from the current root, reaching it again is a cycle
+    c_Visited   = 2,
+};
+
+void AbilityTextWriter::Build(const AbilityGraph& graph)
+{
+    m_Names.clear();
+    m_RootEnd.clear();
+    m_RootSize.clear();
+    m_LeadSize = 0;
+    m_TotalSize = 0;
+    m_CycleDetected = false;
+
+    // Table grows with every id ever used, only reset what the last walk touched
+    for (const size_t id : m_Touched)
+        m_State[id] = c_Unvisited;
+    m_Touched.clear();
+    if (m_State.size() < graph.m_NodeById.size())
+        m_State.resize(graph.m_NodeById.size(), c_Unvisited);
+    m_Touched.reserve(graph.Nodes.size());
+    m_Names.reserve(graph.Nodes.size());
+    m_RootEnd.reserve(graph.root_nodes.size());
+    m_RootSize.reserve(graph.root_nodes.size());
+
+    // Names are separated by a space once the line has something on it
+    bool   lineStart = true;
+    size_t rootSize = 0;
+
+    auto enter = [&](const Node* node)
+        {
+            if (!node)
+                return;
+
+            uint8_t& state = m_State[node->ID.Get()];
+            if (state == c_OnStack)
+            {
+                m_CycleDetected = true;
+                return;
+            }
+            if (state == c_Visited)
+                return;
+
+            m_Touched.push_back(node->ID.Get());
+
+            const std::string_view name = node->Name;
+            m_Names.push_back(name);
+            rootSize += name.size() + (lineStart ? 0 : 1);
+            if (!name.empty())
+                lineStart = false;
+
+            // Constants are leaves, whatever is linked below them
+            if (node->Type == NodeType::Constant)
+            {
+                state = c_Visited;
+                return;
+            }
+
+            state = c_OnStack;
+            m_Stack.push_back({ node, 0 });
+        };
+
+    for (const Node* root : graph.root_nodes)
+    {
+        const size_t rootBegin = m_Names.size();
+        lineStart = true;
+        rootSize = 0;
+
+        enter(root);
+        while (!m_Stack.empty())
+        {
+            Frame& frame = m_Stack.back();
+            if (frame.NextOutput < frame.NodePtr->OutputNodes.size())
+            {
+                // `frame` may move when enter() pushes, don't touch it afterwards
+                enter(frame.NodePtr->OutputNodes[frame.NextOutput++]);
+                continue;
+            }
+
+            m_State[frame.NodePtr->ID.Get()] = c_Visited;
+            m_Stack.pop_back();
+        }
+
+        // Continuing a line puts a space in front of every name up to the first non-empty one
+        if (m_RootEnd.empty())
+        {
+            for (size_t i = rootBegin; i < m_Names.size(); ++i)
+            {
+                ++m_LeadSize;
+                if (!m_Names[i].empty())
+                    break;
+            }
+        }
+
+        rootSize += 1; // '\n'
+        m_RootEnd.push_back(m_Names.size());
+        m_RootSize.push_back(rootSize);
+        m_TotalSize += rootSize;
+    }
+}
+
+size_t AbilityTextWriter::Size(bool continueLine) const
+{
+    return m_TotalSize + (continueLine ? m_LeadSize : 0);
+}
+
+char* AbilityTextWriter::WriteRoots(char* out, size_t firstRoot, size_t lastRoot, bool continueLine) const
+{
+    bool lineStart = !continueLine;
+
+    size_t i = firstRoot > 0 ? m_RootEnd[firstRoot - 1] : 0;
+    for (size_t root = firstRoot; root < lastRoot; ++root)
+    {
+        for (const size_t end = m_RootEnd[root]; i < end; ++i)
+        {
+            const std::string_view name = m_Names[i];
+            if (!lineStart)
+                *out++ = ' ';
+
+            std::memcpy(out, name.data(), name.size());
+            out += name.size();
+
+            if (!name.empty())
+                lineStart = false;
+        }
+
+        *out++ = '\n';
+        lineStart = true;
+    }
+
+    return out;
+}
+
+void AbilityTextWriter::Write(std::string& text) const
+{
+    WriteParallel(text, 1);
+}
+
+void AbilityTextWriter::WriteParallel(std::string& text, unsigned jobs) const
+{
+    if (Empty())
+        return;
+
+    const bool   continueLine = !text.empty() && text.back() != '\n';
+    const size_t offset = text.size();
+    text.resize(offset + Size(continueLine));
+    char* out = &text[offset];
+
+    const size_t rootCount = m_RootEnd.size();
+    if (jobs > rootCount / c_MinRootsPerJob)
+        jobs = static_cast<unsigned>(rootCount / c_MinRootsPerJob);
+
+    if (jobs <= 1)
+    {
+        WriteRoots(out, 0, rootCount, continueLine);
+        return;
+    }
+
+    // Contiguous runs of roots per thread, each writing at its own offset
+    std::vector<std::thread> threads;
+    threads.reserve(jobs - 1);
+
+    size_t root = 0;
+    for (unsigned job = 0; job < jobs; ++job)
+    {
+        const size_t lastRoot = rootCount * (job + 1) / jobs;
+        const bool   lead = continueLine && root == 0;
+
+        size_t size = lead ? m_LeadSize : 0;
+        for (size_t i = root; i < lastRoot; ++i)
+            size += m_RootSize[i];
+
+        if (job + 1 < jobs)
+            threads.emplace_back([this, out, root, lastRoot, lead]() { WriteRoots(out, root, lastRoot, lead); });
+        else
+            WriteRoots(out, root, lastRoot, lead);
+
+        out += size;
+        root = lastRoot;
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void AbilityTextWriter::Write(std::ostream& out, bool continueLine)
+{
+    size_t longest = 0;
+    for (size_t size : m_RootSize)
+        longest = size > longest ? size : longest;
+    m_Scratch.resize(longest + m_LeadSize);
+
+    for (size_t root = 0; root < m_RootEnd.size(); ++root)
+    {
+        const char* end = WriteRoots(&m_Scratch[0], root, root + 1, continueLine && root == 0);
+        out.write(m_Scratch.data(), end - m_Scratch.data());
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// AbilityWriter.h
+//
+// Graph -> text serializer behind AbilityGraph::ParseNodes. Build() walks
+// every root once with an explicit stack and records the names in text
+// order together with the exact size of each line, so writing is a single
+// pass of memcpy into storage sized up front. Roots own disjoint ranges of
+// the output and can be written by several threads at once.
+//
+// A writer keeps its buffers between calls; reuse one per thread to export
+// without allocating.
+
+struct AbilityGraph;
+class Node;
+
+class AbilityTextWriter
+{
+public:
+    // Roots per thread below which WriteParallel() stays on the calling thread.
+    static const size_t c_MinRootsPerJob = 64;
+
+    // Flatten `graph`. Nodes reachable from several roots are written by the
+    // first one only, nodes closing a cycle are skipped and reported by
+    // CycleDetected().
+    void Build(const AbilityGraph& graph);
+
+    bool   Empty() const         { return m_RootEnd.empty(); }
+    bool   CycleDetected() const { return m_CycleDetected; }
+
+    // Exact number of bytes written after text ending in `continueLine`
+    // state (non-empty and not ending with a newline).
+    size_t Size(bool continueLine = false) const;
+
+    // Append one line per root to `text`, same output as ParseNodes.
+    void Write(std::string& text) const;
+
+    // Same as Write(), splitting roots over up to `jobs` threads.
+    void WriteParallel(std::string& text, unsigned jobs) const;
+
+    // Stream one line per root, `continueLine` as for Size().
+    void Write(std::ostream& out, bool continueLine = false);
+
+private:
+    char*  WriteRoots(char* out, size_t firstRoot, size_t lastRoot, bool continueLine) const;
+
+    std::vector<std::string_view> m_Names;          // every written name, in text order
+    std::vector<size_t>           m_RootEnd;        // end of each root in m_Names
+    std::vector<size_t>           m_RootSize;       // bytes of each root, newline included
+    size_t                        m_LeadSize = 0;   // extra bytes of the first root when it continues a line
+    size_t                        m_TotalSize = 0;
+    bool                          m_CycleDetected = false;
+
+    // Build() scratch, kept for reuse
+    struct Frame
+    {
+        const Node* NodePtr;
+        size_t      NextOutput;
+    };
+    std::vector<uint8_t>          m_State;          // per node id, see Build()
+    std::vector<size_t>           m_Touched;        // ids whose m_State is set
+    std::vector<Frame>            m_Stack;
+    std::string                   m_Scratch;        // one line for stream output
+};
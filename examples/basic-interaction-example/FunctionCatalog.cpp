@@ -0,0 +1,428 @@
+#include "FunctionCatalog.h"
+#include <fstream>
+#include <filesystem>
+#include <cctype>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+
+// Cache file: header, RecordCount records, then PoolSize bytes of strings.
+struct CatalogCacheHeader
+{
+    char     Magic[8];
+    uint32_t Version;
+    uint32_t PinTypes;          // PinTypeCount when written, the enum is stored as numbers
+    uint64_t SourceSize;
+    int64_t  SourceTime;
+    uint64_t SourceHash;
+    uint32_t RecordCount;
+    uint32_t PoolSize;
+};
+
+static const char     c_CacheMagic[8] = { 'C', 'N', 'C', 'A', 'T', 'L', 'G', '\0' };
+static const uint32_t c_CacheVersion = 1;
+
+
+void FunctionCatalog::Clear()
+{
+    m_Records.clear();
+    m_Pool.clear();
+    m_Cache.Close();
+    Build();
+}
+
+uint32_t FunctionCatalog::AddString(std::string_view text)
+{
+    // Offset 0 is the empty string
+    if (m_Pool.empty())
+        m_Pool += '\0';
+    if (text.empty())
+        return 0;
+
+    const uint32_t offset = static_cast<uint32_t>(m_Pool.size());
+    m_Pool.append(text.data(), text.size());
+    m_Pool += '\0';
+    return offset;
+}
+
+void FunctionCatalog::Add(std::string_view name, PinType input, const PinType* outputs, int outputCount, std::string_view description)
+{
+    // Adding to a mapped cache, take a copy we can grow
+    if (m_Cache.IsOpen())
+    {
+        m_Records.assign(m_RecordData, m_RecordData + m_RecordCount);
+        m_Pool.assign(m_PoolData, m_PoolSize);
+        m_Cache.Close();
+    }
+
+    Record record = {};
+    record.Name = AddString(name);
+    record.NameSize = static_cast<uint32_t>(name.size());
+    record.Description = AddString(description);
+    record.Input = static_cast<uint8_t>(input);
+
+    std::string sig;
+    sig += PinTypeToString(input);
+    sig += " -> ";
+
+    if (outputCount <= 0)
+    {
+        sig += "void";
+    }
+    else
+    {
+        for (int oi = 0; oi < outputCount && oi < 10; ++oi)
+        {
+            if (oi > 0)
+                sig += ", ";
+            sig += PinTypeToString(outputs[oi]);
+
+            record.Outputs[record.OutputCount++] = static_cast<uint8_t>(outputs[oi]);
+        }
+    }
+
+    record.Signature = AddString(sig);
+
+    m_Records.push_back(record);
+}
+
+void FunctionCatalog::Build()
+{
+    if (!m_Cache.IsOpen())
+    {
+        m_RecordData = m_Records.data();
+        m_RecordCount = m_Records.size();
+        m_PoolData = m_Pool.data();
+        m_PoolSize = m_Pool.size();
+    }
+
+    Functions.clear();
+    Functions.resize(m_RecordCount);
+
+    m_Index.clear();
+    m_Index.reserve(m_RecordCount);
+    for (auto& list : m_ByInput)
+        list.clear();
+
+    for (int i = 0; i < static_cast<int>(m_RecordCount); ++i)
+    {
+        const Record& record = m_RecordData[i];
+
+        function& f = Functions[i];
+        f.Name = std::string_view(m_PoolData + record.Name, record.NameSize);
+        f.input = static_cast<PinType>(record.Input);
+        f.output_size = record.OutputCount;
+        for (int oi = 0; oi < record.OutputCount; ++oi)
+            f.output[oi] = static_cast<PinType>(record.Outputs[oi]);
+        f.description = m_PoolData + record.Description;
+
+        auto inserted = m_Index.try_emplace(f.Name);
+        Entry& entry = inserted.first->second;
+        if (inserted.second)
+        {
+            entry.First = i;
+            for (int& overload : entry.ByInput)
+                overload = -1;
+        }
+
+        // First overload per input type wins, same as the old linear scan
+        int& overload = entry.ByInput[static_cast<int>(f.input)];
+        if (overload < 0)
+            overload = i;
+
+        m_ByInput[static_cast<int>(f.input)].push_back(i);
+    }
+}
+
+bool FunctionCatalog::SaveCache(const char* path, const CatalogSource& source) const
+{
+    CatalogCacheHeader header = {};
+    std::memcpy(header.Magic, c_CacheMagic, sizeof(header.Magic));
+    header.Version = c_CacheVersion;
+    header.PinTypes = PinTypeCount;
+    header.SourceSize = source.Size;
+    header.SourceTime = source.Time;
+    header.SourceHash = source.Hash;
+    header.RecordCount = static_cast<uint32_t>(m_RecordCount);
+    header.PoolSize = static_cast<uint32_t>(m_PoolSize);
+
+    // Write next to the target and rename, so a reader never maps half a file
+    const std::string temp = std::string(path) + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(m_RecordData), m_RecordCount * sizeof(Record));
+        file.write(m_PoolData, m_PoolSize);
+        if (!file)
+        {
+            file.close();
+            std::error_code error;
+            fs::remove(temp, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temp, path, error);
+    if (error)
+    {
+        fs::remove(temp, error);
+        return false;
+    }
+
+    return true;
+}
+
+bool FunctionCatalog::LoadCache(const char* path, const CatalogSource& source)
+{
+    Clear();
+
+    if (!m_Cache.Open(path))
+        return false;
+
+    const char* data = m_Cache.Data();
+    const size_t size = m_Cache.Size();
+
+    CatalogCacheHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid)
+    {
+        std::memcpy(&header, data, sizeof(header));
+        valid = std::memcmp(header.Magic, c_CacheMagic, sizeof(header.Magic)) == 0
+            && header.Version == c_CacheVersion
+            && header.PinTypes == static_cast<uint32_t>(PinTypeCount)
+            && header.SourceSize == source.Size
+            && header.SourceTime == source.Time
+            && header.SourceHash == source.Hash
+            && size == sizeof(header) + header.RecordCount * sizeof(Record) + header.PoolSize;
+    }
+
+    const Record* records = reinterpret_cast<const Record*>(data + sizeof(header));
+    const char*   pool = data + sizeof(header) + (valid ? header.RecordCount * sizeof(Record) : 0);
+
+    // Never trust offsets of a file on disk, a bad one would read past the mapping
+    valid = valid && header.PoolSize > 0 && pool[header.PoolSize - 1] == '\0';
+    for (uint32_t i = 0; valid && i < header.RecordCount; ++i)
+    {
+        const Record& record = records[i];
+        valid = record.Name < header.PoolSize
+            && record.NameSize < header.PoolSize - record.Name
+            && record.Description < header.PoolSize
+            && record.Signature < header.PoolSize
+            && record.Input < PinTypeCount
+            && record.OutputCount <= 10;
+
+        for (int oi = 0; valid && oi < record.OutputCount; ++oi)
+            valid = record.Outputs[oi] < PinTypeCount;
+    }
+
+    if (!valid)
+    {
+        m_Cache.Close();
+        Build();
+        return false;
+    }
+
+    m_RecordData = records;
+    m_RecordCount = header.RecordCount;
+    m_PoolData = pool;
+    m_PoolSize = header.PoolSize;
+    Build();
+
+    return true;
+}
+
+const function* FunctionCatalog::FindAny(std::string_view name) const
+{
+    auto it = m_Index.find(name);
+    if (it == m_Index.end())
+        return nullptr;
+
+    return &Functions[it->second.First];
+}
+
+const function* FunctionCatalog::Find(std::string_view name, PinType expected) const
+{
+    auto it = m_Index.find(name);
+    if (it == m_Index.end())
+        return nullptr;
+
+    // Perfect match: same name + same input type, otherwise the first
+    // function with that name as a fallback
+    int index = it->second.ByInput[static_cast<int>(expected)];
+    if (index < 0)
+        index = it->second.First;
+
+    return &Functions[index];
+}
+
+
+
+uint64_t HashCatalogSource(const char* data, size_t size)
+{
+    // FNV-1a over 8 byte words, enough to notice an edited file
+    const uint64_t prime = 1099511628211ull;
+    uint64_t hash = 14695981039346656037ull ^ size;
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+
+    return hash;
+}
+
+static std::string_view Trim(std::string_view text)
+{
+    std::size_t start = 0;
+    while (start < text.size() && std::isspace(static_cast<unsigned char>(text[start])))
+        ++start;
+
+    std::size_t end = text.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(text[end - 1])))
+        --end;
+
+    return text.substr(start, end - start);
+}
+
+static void ParseModInfoText(FunctionCatalog& catalog, std::string_view text)
+{
+    bool hasCategory = false;
+    PinType currentCategory = PinType::Trigger; // dummy init
+
+    std::size_t lineBegin = 0;
+    while (lineBegin < text.size())
+    {
+        std::size_t lineEnd = text.find('\n', lineBegin);
+        if (lineEnd == std::string_view::npos)
+            lineEnd = text.size();
+
+        // trim whitespace from both ends
+        const std::string_view trimmed = Trim(text.substr(lineBegin, lineEnd - lineBegin));
+        lineBegin = lineEnd + 1;
+
+        if (trimmed.empty())
+            continue;
+
+        if (trimmed == "Modding Info")
+            continue;
+
+        // category header: e.g. "Trigger:"
+        if (trimmed.back() == ':')
+        {
+            PinType pt;
+            if (PinTypeFromString(trimmed.substr(0, trimmed.size() - 1), pt))
+            {
+                currentCategory = pt;
+                hasCategory = true;
+            }
+            else
+            {
+                hasCategory = false;
+            }
+        }
+
+        if (!hasCategory)
+            continue;
+
+        // split into before/inside quotes
+        std::string_view beforeQuote = trimmed;
+        std::string_view description;
+
+        std::size_t firstQuote = trimmed.find('"');
+        if (firstQuote != std::string_view::npos)
+        {
+            beforeQuote = trimmed.substr(0, firstQuote);
+
+            std::size_t lastQuote = trimmed.find_last_of('"');
+            if (lastQuote != std::string_view::npos && lastQuote > firstQuote)
+            {
+                // raw description (keeps colour codes etc.; you can clean it later if you want)
+                description = trimmed.substr(firstQuote + 1, lastQuote - firstQuote - 1);
+            }
+        }
+
+        beforeQuote = Trim(beforeQuote);
+        if (beforeQuote.empty())
+            continue;
+
+        // tokenize by whitespace: name, then argument tokens mapped to PinType outputs
+        std::string_view name;
+        PinType outputs[10];
+        int outputCount = 0;
+
+        std::size_t pos = 0;
+        while (pos < beforeQuote.size() && outputCount < 10)
+        {
+            while (pos < beforeQuote.size() &&
+                std::isspace(static_cast<unsigned char>(beforeQuote[pos])))
+                ++pos;
+
+            if (pos >= beforeQuote.size())
+                break;
+
+            std::size_t j = pos;
+            while (j < beforeQuote.size() &&
+                !std::isspace(static_cast<unsigned char>(beforeQuote[j])))
+                ++j;
+
+            const std::string_view token = beforeQuote.substr(pos, j - pos);
+            pos = j;
+
+            if (name.empty())
+            {
+                name = token;
+                continue;
+            }
+
+            PinType pt;
+            if (PinTypeFromString(token, pt))
+                outputs[outputCount++] = pt;
+        }
+
+        catalog.Add(name, currentCategory, outputs, outputCount, description);
+    }
+}
+
+bool ParseModInfo(FunctionCatalog& catalog, const char* path, bool useCache)
+{
+    catalog.Clear();
+
+    std::error_code error;
+    CatalogSource source;
+    source.Size = fs::file_size(path, error);
+    if (error)
+        return false;
+    source.Time = static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+    if (error)
+        return false;
+
+    // Hash straight from the mapping, parsing reads from it too if the cache is stale
+    MappedFile file;
+    if (source.Size > 0 && !file.Open(path))
+        return false;
+    source.Hash = HashCatalogSource(file.Data(), file.Size());
+
+    const std::string cachePath = std::string(path) + ".cache";
+    if (useCache && catalog.LoadCache(cachePath.c_str(), source))
+        return true;
+
+    ParseModInfoText(catalog, std::string_view(file.Data(), file.Size()));
+    catalog.Build();
+
+    // Best effort, a read only install just parses every time
+    if (useCache)
+        catalog.SaveCache(cachePath.c_str(), source);
+
+    return true;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Nodes.h"
+#include "MappedFile.h"
+
+// FunctionCatalog.h
+//
+// All functions known from ModdingInfo.txt plus lookup tables built once at
+// load time. Name lookups and overload resolution are a single hash probe,
+// the per input type lists back the Shift+A search popup.
+//
+// Functions are fixed-size records whose strings live in one pool, so the
+// whole catalog can be written to a binary cache and mapped back in without
+// parsing (see ParseModInfo). Functions and the index keys point into that
+// pool and stay valid until the next Clear() or load. The catalog is read
+// only once built and can be shared between threads.
+
+// Identity of the ModdingInfo.txt a cache was built from.
+struct CatalogSource
+{
+    uint64_t Size = 0;
+    int64_t  Time = 0;          // last write time, in file clock ticks
+    uint64_t Hash = 0;          // of the whole file, see HashCatalogSource
+};
+
+struct FunctionCatalog
+{
+    // Rebuilt from the records by Build(), don't edit directly.
+    std::vector<function> Functions{};
+
+    FunctionCatalog() = default;
+    FunctionCatalog(const FunctionCatalog&) = delete;
+    FunctionCatalog& operator=(const FunctionCatalog&) = delete;
+
+    void Clear();
+
+    // Append a function, strings are copied into the pool. Call Build() once
+    // everything is added.
+    void Add(std::string_view name, PinType input, const PinType* outputs, int outputCount, std::string_view description);
+
+    // (Re)build Functions and lookup tables from the records.
+    void Build();
+
+    // Write the records and pool to `path`, stamped with `source`.
+    bool SaveCache(const char* path, const CatalogSource& source) const;
+
+    // Map a cache written by SaveCache and Build() from it. Fails, leaving
+    // the catalog empty, if the file is missing, damaged or stamped with
+    // anything but `source`.
+    bool LoadCache(const char* path, const CatalogSource& source);
+
+    // Any function with this name (first one in file order).
+    const function* FindAny(std::string_view name) const;
+
+    // Overload-aware: function with this name whose input is `expected`,
+    // otherwise the first function with this name, otherwise nullptr.
+    const function* Find(std::string_view name, PinType expected) const;
+
+    // Indices into Functions of every function taking `input`, in file order.
+    const std::vector<int>& WithInput(PinType input) const { return m_ByInput[static_cast<int>(input)]; }
+
+    // "InputType -> Out1, Out2" / "InputType -> void", precomputed per function.
+    const char* Signature(int index) const { return m_PoolData + m_RecordData[index].Signature; }
+
+    bool   empty() const { return Functions.empty(); }
+    size_t size() const  { return Functions.size(); }
+
+    const function& operator[](size_t index) const { return Functions[index]; }
+
+private:
+    // Same layout in memory and in the cache file
+    struct Record
+    {
+        uint32_t Name;          // offsets into the pool, strings are null terminated
+        uint32_t NameSize;
+        uint32_t Description;
+        uint32_t Signature;
+        uint8_t  Input;
+        uint8_t  OutputCount;
+        uint8_t  Outputs[10];
+    };
+
+    struct Entry
+    {
+        int First = -1;               // first overload in file order
+        int ByInput[PinTypeCount];    // overload per input type, -1 if none
+    };
+
+    uint32_t AddString(std::string_view text);
+
+    // Records and pool in use: either the vectors below or the mapped cache
+    std::vector<Record>                         m_Records;
+    std::string                                 m_Pool;
+    MappedFile                                  m_Cache;
+    const Record*                               m_RecordData = nullptr;
+    size_t                                      m_RecordCount = 0;
+    const char*                                 m_PoolData = nullptr;
+    size_t                                      m_PoolSize = 0;
+
+    std::unordered_map<std::string_view, Entry> m_Index;
+    std::vector<int>                            m_ByInput[PinTypeCount];
+};
+
+// Hash of ModdingInfo.txt contents stored in its cache.
+uint64_t HashCatalogSource(const char* data, size_t size);
+
+// Read ModdingInfo.txt into `catalog` and build its index.
+//
+// With `useCache` the catalog is mapped from "<path>.cache" when that was
+// built from the same file (size, write time and hash), otherwise the text
+// is parsed and the cache rewritten for the next launch.
+bool ParseModInfo(FunctionCatalog& catalog, const char* path = "ModdingInfo.txt", bool useCache = true);
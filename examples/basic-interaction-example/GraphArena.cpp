@@ -0,0 +1,122 @@
+#include "GraphArena.h"
+#include <algorithm>
+#include <cstring>
+
+
+static size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void* GraphArena::Allocate(size_t size, size_t alignment)
+{
+    // Fast path: room left in the current block
+    if (m_Current < m_Blocks.size())
+    {
+        Block& block = m_Blocks[m_Current];
+        size_t offset = AlignUp(m_Offset, alignment);
+        if (offset + size <= block.Size)
+        {
+            m_Offset = offset + size;
+            return block.Memory.get() + offset;
+        }
+    }
+
+    // Move to the next block that fits, reusing blocks kept by Reset()
+    size_t next = m_Blocks.empty() ? 0 : m_Current + 1;
+    while (next < m_Blocks.size() && m_Blocks[next].Size < size)
+        ++next;
+
+    if (next >= m_Blocks.size())
+    {
+        size_t blockSize = m_Blocks.empty() ? c_FirstBlockSize : m_Blocks.back().Size * 2;
+        if (blockSize > c_BlockSize)
+            blockSize = c_BlockSize;
+
+        Block block;
+        block.Size = size > blockSize ? size : blockSize;
+        block.Memory.reset(new char[block.Size]);
+        m_Blocks.push_back(std::move(block));
+        next = m_Blocks.size() - 1;
+    }
+
+    m_Current = next;
+
+    // Block memory comes from operator new[] and is aligned for any fundamental type
+    m_Offset = size;
+    return m_Blocks[m_Current].Memory.get();
+}
+
+void GraphArena::Reserve(size_t size)
+{
+    if (size == 0)
+        return;
+
+    size_t next = 0;
+    if (m_Current < m_Blocks.size())
+    {
+        if (m_Blocks[m_Current].Size - m_Offset >= size)
+            return;
+
+        // Start after a partially filled block
+        next = m_Offset > 0 ? m_Current + 1 : m_Current;
+    }
+
+    if (next < m_Blocks.size() && m_Blocks[next].Size >= size)
+    {
+        m_Current = next;
+        m_Offset = 0;
+        return;
+    }
+
+    Block block;
+    block.Size = size;
+    block.Memory.reset(new char[block.Size]);
+    m_Blocks.insert(m_Blocks.begin() + next, std::move(block));
+
+    m_Current = next;
+    m_Offset = 0;
+}
+
+const char* GraphArena::CopyString(std::string_view text)
+{
+    char* result = static_cast<char*>(Allocate(text.size() + 1, 1));
+    if (!text.empty())
+        std::memcpy(result, text.data(), text.size());
+    result[text.size()] = '\0';
+    return result;
+}
+
+void GraphArena::Reset()
+{
+    // Oversized blocks were made by Reserve() or for a single large
+    // allocation. Keep the largest one first, so reserving room for a graph
+    // of similar size on the next parse reuses it, and drop the others.
+    auto largest = std::max_element(m_Blocks.begin(), m_Blocks.end(),
+        [](const Block& lhs, const Block& rhs) { return lhs.Size < rhs.Size; });
+    if (largest != m_Blocks.end() && largest->Size > c_BlockSize)
+    {
+        std::rotate(m_Blocks.begin(), largest, largest + 1);
+        m_Blocks.erase(std::remove_if(m_Blocks.begin() + 1, m_Blocks.end(),
+            [](const Block& block) { return block.Size > c_BlockSize; }), m_Blocks.end());
+    }
+
+    m_Current = 0;
+    m_Offset = 0;
+}
+
+size_t GraphArena::BytesUsed() const
+{
+    size_t used = 0;
+    for (size_t i = 0; i < m_Current && i < m_Blocks.size(); ++i)
+        used += m_Blocks[i].Size;
+    return used + m_Offset;
+}
+
+size_t GraphArena::BytesReserved() const
+{
+    size_t reserved = 0;
+    for (auto& block : m_Blocks)
+        reserved += block.Size;
+    return reserved;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// GraphArena.h
+//
+// Block allocator owning the Nodes and Pins of an AbilityGraph together with
+// their name strings and pin arrays. Objects are bump allocated one after
+// another, so a freshly parsed graph is laid out contiguously, and Reset()
+// releases everything in O(1) while keeping the blocks for the next parse.
+//
+// Nothing allocated here is ever destroyed, only trivially destructible
+// types may be placed into the arena.
+
+template <typename T>
+struct ArenaArray
+{
+    T*  Data = nullptr;
+    int Size = 0;
+
+    T*       begin()       { return Data; }
+    T*       end()         { return Data + Size; }
+    const T* begin() const { return Data; }
+    const T* end() const   { return Data + Size; }
+
+    size_t size() const  { return static_cast<size_t>(Size); }
+    bool   empty() const { return Size == 0; }
+
+    T&       operator[](size_t index)       { return Data[index]; }
+    const T& operator[](size_t index) const { return Data[index]; }
+};
+
+class GraphArena
+{
+public:
+    static const size_t c_FirstBlockSize = 1024;      // small graphs stay small
+    static const size_t c_BlockSize = 64 * 1024;      // blocks double up to this size
+
+    GraphArena() = default;
+    GraphArena(const GraphArena&) = delete;
+    GraphArena& operator=(const GraphArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+
+    template <typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "GraphArena never runs destructors");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    ArenaArray<T> NewArray(int size, const T& value = T())
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "GraphArena never runs destructors");
+        ArenaArray<T> result;
+        if (size <= 0)
+            return result;
+        result.Data = static_cast<T*>(Allocate(sizeof(T) * size, alignof(T)));
+        result.Size = size;
+        for (int i = 0; i < size; ++i)
+            new (result.Data + i) T(value);
+        return result;
+    }
+
+    // Make room for `size` more bytes in one block, so a caller that knows how
+    // much it is going to allocate does not pay for doubling block sizes.
+    void Reserve(size_t size);
+
+    // Null terminated copy of `text`.
+    const char* CopyString(std::string_view text);
+
+    // Forget every allocation. Blocks are kept and reused, of oversized ones
+    // only the largest is kept.
+    void Reset();
+
+    size_t BytesUsed() const;
+    size_t BytesReserved() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> Memory;
+        size_t                  Size = 0;
+    };
+
+    std::vector<Block> m_Blocks;
+    size_t             m_Current = 0;   // block being filled
+    size_t             m_Offset = 0;    // first free byte in m_Blocks[m_Current]
+};
@@ -0,0 +1,112 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path)
+{
+    Close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Mapping = mapping;
+    m_Data = static_cast<const char*>(data);
+    m_Size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_Data)
+        UnmapViewOfFile(m_Data);
+    if (m_Mapping)
+        CloseHandle(m_Mapping);
+    if (m_File)
+        CloseHandle(m_File);
+
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Mapping = nullptr;
+    m_File = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const char* path)
+{
+    Close();
+
+    const int file = open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size <= 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps the file alive on its own
+    close(file);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_Data = static_cast<const char*>(data);
+    m_Size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_Data)
+        munmap(const_cast<char*>(m_Data), m_Size);
+
+    m_Data = nullptr;
+    m_Size = 0;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+// MappedFile.h
+//
+// Read only memory mapping of a whole file (CreateFileMapping on Windows,
+// mmap elsewhere). The view stays valid until Close() or destruction.
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    // Map `path`, closing any previous mapping. False if the file cannot be
+    // opened or is empty.
+    bool Open(const char* path);
+    void Close();
+
+    const char* Data() const { return m_Data; }
+    size_t      Size() const { return m_Size; }
+    bool        IsOpen() const { return m_Data != nullptr; }
+
+private:
+    const char* m_Data = nullptr;
+    size_t      m_Size = 0;
+#ifdef _WIN32
+    void*       m_File = nullptr;
+    void*       m_Mapping = nullptr;
+#endif
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <algorithm>
 #include <imgui.h>
 #include <imgui_node_editor.h>
+#include "GraphArena.h"
 
 namespace ed = ax::NodeEditor;
 
@@ -36,6 +39,8 @@ enum class PinType
     WORD      
 };
 
+constexpr int PinTypeCount = static_cast<int>(PinType::WORD) + 1;
+
 enum class PinKind { Output, Input };
 enum class NodeType { Basic, Primary, Constant}; //basic has 1 input and n outputs, primary has no inputs and n outputs and constant has 1 input and 0 outputs
 // Nodes.h
@@ -72,7 +77,7 @@ inline const char* PinTypeToString(PinType t)
 
 // Nodes.h
 
-inline bool PinTypeFromString(const std::string& s, PinType& out)
+inline bool PinTypeFromString(std::string_view s, PinType& out)
 {
     if (s == "Trigger") { out = PinType::Trigger;   return true; }
 
@@ -248,13 +253,14 @@ class LinkInfo
 };
 
 class Node; // forward declaration
+struct AbilityBlock;
 
 class Pin
 {
 public:
     ed::PinId   ID;
     Node* NodePtr = nullptr;
-    std::string Name;
+    const char* Name;
     PinType     Type;
     PinKind     Kind;
 
@@ -267,28 +273,32 @@ public:
         this->Name = PinTypeToString(Type);
     }
 };
+
+// Nodes and pins live in the GraphArena of their AbilityBlock and are never
+// deleted one by one, so everything in them has to be trivially destructible.
 class Node
 {
 public:
     ed::NodeId ID;
-    std::string Name;
+    const char* Name;                   // owned by the block arena
     Pin* InputPin;
-    std::vector<Pin*> OutputPins;
+    ArenaArray<Pin*> OutputPins;
     Node* InputNode = nullptr;
-    std::vector<Node*> OutputNodes;
+    ArenaArray<Node*> OutputNodes;
     ImColor Color;
     NodeType Type = NodeType::Basic;
     ImVec2 Start_pos;
     
-    std::string description = "";
+    const char* description = "";      // not owned, usually points into the FunctionCatalog
+    AbilityBlock* Block = nullptr;      // block owning this node, see AbilityGraph
 
-    Node(ed::NodeId ID, std::string Name, Pin* InputPin, std::vector<Pin*> OutputPins, ImVec2 Start_pos, std::string desc = "", NodeType nodetype = NodeType::Basic)
+    Node(ed::NodeId ID, const char* Name, Pin* InputPin, ArenaArray<Pin*> OutputPins, ArenaArray<Node*> OutputNodes, ImVec2 Start_pos, const char* desc = "", NodeType nodetype = NodeType::Basic)
     {
         this->ID = ID;
         this->Name = Name;
         this->InputPin = InputPin;
         this->OutputPins = OutputPins;
-        OutputNodes.resize(OutputPins.size(),nullptr);
+        this->OutputNodes = OutputNodes;
         this->Start_pos = Start_pos;
         this->Type = nodetype;
 
@@ -318,29 +328,20 @@ public:
         for (Pin* p : OutputPins)
             erase_one(p);
     }
-    
-
-    ~Node()
-    {
-        delete InputPin;
-        for (auto pin : OutputPins)
-        {
-            delete pin;
-        }
-
-    }
 
 };
 
 
 
+// Strings point into the pool of the FunctionCatalog holding the function,
+// Name is null terminated too.
 struct function
 {
-    std::string Name;
+    std::string_view Name;
     PinType input;
     PinType output[10];
     int output_size;
-    std::string description = "";
+    const char* description = "";
 };
 
 
@@ -2,17 +2,28 @@
 #include <imgui_node_editor.h>
 #include <application.h>
 #include <vector>
-#include <fstream>
 #include <cctype>
 #include <unordered_set>
-#include <functional>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include "Nodes.h"
+#include "AbilityGraph.h"
 
 namespace ed = ax::NodeEditor;
 
+// Nodes this far (canvas units) outside the view are not built, only ghosted
+static const float c_NodeCullMargin = 64.0f;
+
+// Zoomed out past this (ed::GetCurrentZoom) text is unreadable, nodes are
+// built empty and drawn as their background with pin colour stripes
+static const float c_NodeLodZoom = 2.5f;
+static const float c_NodeLodStripeWidth = 8.0f;
 
-static bool StartsWithCaseInsensitive(const std::string& text, const std::string& prefix)
+
+static bool StartsWithCaseInsensitive(std::string_view text, const std::string& prefix)
 {
     if (prefix.empty())
         return true;
@@ -34,18 +45,16 @@ static bool StartsWithCaseInsensitive(const std::string& text, const std::string
 
 
 struct Example :
-    public Application
+    public Application,
+    public AbilityGraph
 {
-    int uniqueId = 1;
-
-    std::vector<Node*> Nodes{};
     std::vector<LinkInfo*> Links{};
-    std::vector<Pin*> Pins{};
 
-    std::vector<function> funcs{};
+    FunctionCatalog funcs{};
     std::string g_TextToParse = "";
 
-    std::vector<Node*> root_nodes{};
+    std::string m_ModInfoPath = "ModdingInfo.txt";  // --modinfo <file>
+    std::string m_TextPath;                          // --text <file>, parsed at start
 
     // --- Quick node creation UI ("Shift + A") ---
     bool   m_ShowCreateNode = false;
@@ -55,309 +64,40 @@ struct Example :
     char   m_CreateNodeFilter[64] = { 0 };   // text filter (function name prefix)
     int    m_CreateNodeTypeFilter = 0;       // 0 = All, 1..N = specific PinType
 
+    std::vector<int> m_CreateNodeResults;          // indices into funcs passing both filters
+    std::string      m_CreateNodeResultsFilter;    // filters m_CreateNodeResults was built for
+    int              m_CreateNodeResultsType = -1;
 
-
-
-    const float LAYOUT_X_STEP = 230.0f;    // horizontal spacing between columns
-    const float LAYOUT_Y_STEP = 90.0f;     // vertical spacing between siblings
-    const float LAYOUT_ROOT_GAP = 120.0f;    // vertical gap between different root trees
-
-    // Recursively layout a subtree. Returns "height" in rows.
-    float LayoutSubtree(Node* node, int depth, float& yCursor,
-        std::unordered_set<Node*>& visited)
+    void UpdateCreateNodeResults()
     {
-        if (!node)
-            return 0.0f;
-
-        // Avoid infinite recursion on cycles
-        if (visited.count(node))
-            return 0.0f;
-        visited.insert(node);
-
-        // Gather real children (skip nulls)
-        std::vector<Node*> children;
-        children.reserve(node->OutputNodes.size());
-        for (Node* c : node->OutputNodes)
-            if (c)
-                children.push_back(c);
-
-        // Leaf node: just place it and advance y
-        if (children.empty())
-        {
-            node->Start_pos = ImVec2(depth * LAYOUT_X_STEP, yCursor);
-            yCursor += LAYOUT_Y_STEP;
-            return 1.0f;
-        }
+        m_CreateNodeResultsFilter = m_CreateNodeFilter;
+        m_CreateNodeResultsType = m_CreateNodeTypeFilter;
+        m_CreateNodeResults.clear();
 
-        // Internal node: first layout children, then place node in the vertical middle
-        float subtreeStartY = yCursor;
-        float totalRows = 0.0f;
-
-        for (Node* c : children)
-        {
-            totalRows += LayoutSubtree(c, depth + 1, yCursor, visited);
-        }
-
-        if (totalRows <= 0.0f)
-            totalRows = 1.0f; // safety
-
-        float centerY = subtreeStartY + (totalRows * LAYOUT_Y_STEP) * 0.5f;
-        node->Start_pos = ImVec2(depth * LAYOUT_X_STEP, centerY);
-
-        return totalRows;
-    }
-
-    // Layout all graphs starting from root_nodes
-    void AutoLayoutGraphs()
-    {
-        std::unordered_set<Node*> visited;
-        float rootY = 0.0f;
+        auto accept = [&](int i)
+            {
+                // Name prefix filter (case-insensitive)
+                if (StartsWithCaseInsensitive(funcs[i].Name, m_CreateNodeResultsFilter))
+                    m_CreateNodeResults.push_back(i);
+            };
 
-        for (Node* root : root_nodes)
+        if (m_CreateNodeTypeFilter != 0)
         {
-            if (!root)
-                continue;
-
-            float yCursor = rootY;
-            float rows = LayoutSubtree(root, /*depth=*/0, yCursor, visited);
-
-            // Leave some gap before the next root tree
-            rootY = yCursor + LAYOUT_ROOT_GAP;
+            PinType expected = GetAllPinTypes()[m_CreateNodeTypeFilter - 1].type;
+            for (int i : funcs.WithInput(expected))
+                accept(i);
         }
-    }
-
-    Pin* MakePin(PinType type, PinKind kind)
-    {
-        auto* pin = new Pin{ ed::PinId(uniqueId++), type, kind };
-        Pins.push_back(pin);
-        return pin;
-    }
-
-    Node* MakeBasicNode(const std::string& name,
-        PinType inputType,
-        std::initializer_list<PinType> outputTypes,
-        ImVec2 startPos, std::string desc = "", NodeType nodetype = NodeType::Basic)
-    {
-        Pin* inputPin = MakePin(inputType, PinKind::Input);
-
-        std::vector<Pin*> outputs;
-        outputs.reserve(outputTypes.size());
-        for (auto t : outputTypes)
-            outputs.push_back(MakePin(t, PinKind::Output));
-
-        auto* node = new Node{ ed::NodeId(uniqueId++), name, inputPin, std::move(outputs), startPos, desc,nodetype };
-
-        inputPin->NodePtr = node;
-        for (auto t : outputs)
+        else
         {
-            t->NodePtr = node;
+            for (int i = 0; i < static_cast<int>(funcs.size()); ++i)
+                accept(i);
         }
-        Nodes.push_back(node);
-        if (nodetype == NodeType::Primary) { root_nodes.push_back(node); }
-        return node;
     }
 
-    Node* NodeFromFunciton(const function& f, ImVec2 startPos)
-    {
-
-        Node* node = nullptr;
-
-        switch (f.output_size)
-        {
-        case 0:
-            node = MakeBasicNode(f.Name, f.input, {}, startPos);
-            break;
-        case 1:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0] }, startPos);
-            break;
-        case 2:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1] }, startPos);
-            break;
-        case 3:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2] }, startPos);
-            break;
-        case 4:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3] }, startPos);
-            break;
-        case 5:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4] }, startPos);
-            break;
-        case 6:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4], f.output[5] }, startPos);
-            break;
-        case 7:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4], f.output[5], f.output[6] }, startPos);
-            break;
-        case 8:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4], f.output[5], f.output[6], f.output[7] }, startPos);
-            break;
-        case 9:
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4], f.output[5], f.output[6], f.output[7],
-                  f.output[8] }, startPos);
-            break;
-        default: // 10 or more: clamp to first 10 (struct only stores 10)
-            node = MakeBasicNode(f.Name, f.input,
-                { f.output[0], f.output[1], f.output[2], f.output[3],
-                  f.output[4], f.output[5], f.output[6], f.output[7],
-                  f.output[8], f.output[9] }, startPos);
-            break;
-        }
-
-        if (node)
-        {
-            node->description = f.description;
-
-        }
-
-        return node;
-    }
 
 
 
-    void ParseModInfo(std::vector<function>& dir)
-    {
-        dir.clear();
-
-        std::ifstream file("ModdingInfo.txt");
-        if (!file.is_open())
-            return;
-
-        std::string line;
-        bool hasCategory = false;
-        PinType currentCategory = PinType::Trigger; // dummy init
-
-        while (std::getline(file, line))
-        {
-            // trim whitespace from both ends
-            std::size_t start = 0;
-            while (start < line.size() && std::isspace(static_cast<unsigned char>(line[start])))
-                ++start;
-
-            std::size_t end = line.size();
-            while (end > start && std::isspace(static_cast<unsigned char>(line[end - 1])))
-                --end;
-
-            if (start >= end)
-                continue;
-
-            std::string trimmed = line.substr(start, end - start);
-
-            if (trimmed == "Modding Info")
-                continue;
-
-            // category header: e.g. "Trigger:"
-            if (trimmed.back() == ':')
-            {
-                std::string cat = trimmed.substr(0, trimmed.size() - 1);
-
-                
-                PinType pt;
-                if (PinTypeFromString(cat, pt))
-                {
-                    currentCategory = pt;
-                    hasCategory = true;
-                }
-                else
-                {
-                    hasCategory = false;
-                }
-            }
-
-            if (!hasCategory)
-                continue;
-
-            // split into before/inside quotes
-            std::string beforeQuote = trimmed;
-            std::string description;
-
-            std::size_t firstQuote = trimmed.find('"');
-            if (firstQuote != std::string::npos)
-            {
-                beforeQuote = trimmed.substr(0, firstQuote);
-
-                std::size_t lastQuote = trimmed.find_last_of('"');
-                if (lastQuote != std::string::npos && lastQuote > firstQuote)
-                {
-                    // raw description (keeps colour codes etc.; you can clean it later if you want)
-                    description = trimmed.substr(firstQuote + 1, lastQuote - firstQuote - 1);
-                }
-            }
-
-            // re-trim beforeQuote
-            std::size_t bs = 0;
-            while (bs < beforeQuote.size() && std::isspace(static_cast<unsigned char>(beforeQuote[bs])))
-                ++bs;
-            std::size_t be = beforeQuote.size();
-            while (be > bs && std::isspace(static_cast<unsigned char>(beforeQuote[be - 1])))
-                --be;
-
-            if (bs >= be)
-                continue;
-
-            beforeQuote = beforeQuote.substr(bs, be - bs);
-
-            // tokenize by whitespace
-            std::vector<std::string> tokens;
-            std::size_t pos = 0;
-            while (pos < beforeQuote.size())
-            {
-                while (pos < beforeQuote.size() &&
-                    std::isspace(static_cast<unsigned char>(beforeQuote[pos])))
-                    ++pos;
-
-                if (pos >= beforeQuote.size())
-                    break;
-
-                std::size_t j = pos;
-                while (j < beforeQuote.size() &&
-                    !std::isspace(static_cast<unsigned char>(beforeQuote[j])))
-                    ++j;
-
-                tokens.emplace_back(beforeQuote.substr(pos, j - pos));
-                pos = j;
-            }
-
-            if (tokens.empty())
-                continue;
-
-            function f;
-            f.Name = tokens[0];
-            f.input = currentCategory;
-            f.output_size = 0;
-            f.description = description;
-
-            // map argument tokens to PinType outputs
-            for (std::size_t i = 1; i < tokens.size() && f.output_size < 10; ++i)
-            {
-                const std::string& t = tokens[i];
-                PinType pt;
-                bool isType = PinTypeFromString(t, pt);
-
-                if (isType)
-                {
-                    f.output[f.output_size++] = pt;
-                }
-            }
-
-            dir.push_back(f);
-        }
-    }
-
-    void DrawNode(Node* node) const
+    void DrawNode(Node* node)
     {
         if (m_FirstFrame)
             ed::SetNodePosition(node->ID, node->Start_pos);
@@ -368,7 +108,7 @@ struct Example :
         if (node->Type == NodeType::Constant)
             ImGui::Text("Constant");
         else
-            ImGui::Text("%s", node->Name.c_str());
+            ImGui::Text("%s", node->Name);
 
 
 // Left side: input
@@ -420,13 +160,13 @@ struct Example :
 
             // Use a small buffer; copy from node->Name
             char buf[128];
-            std::snprintf(buf, sizeof(buf), "%s", node->Name.c_str());
+            std::snprintf(buf, sizeof(buf), "%s", node->Name);
 
             ImGui::PushItemWidth(120.0f);
             if (ImGui::InputText("##ConstName", buf, IM_ARRAYSIZE(buf)))
             {
-                // Write the edited name back into the node
-                node->Name = buf;
+                // Write the edited name back into the node, old copy stays in the arena until its block is rebuilt
+                RenameNode(node, buf);
             }
             ImGui::PopItemWidth();
 
@@ -437,410 +177,164 @@ struct Example :
     }
 
 
-    void DrawNodes(std::vector<Node*> nodes)
+    void DrawNodeLod(Node* node)
     {
-        for (Node* node : nodes)
+        // Size of the full node is known only after it was built once
+        const ImVec2 size = ed::GetNodeSize(node->ID);
+        if (size.x <= 0.0f || size.y <= 0.0f)
         {
             DrawNode(node);
-        }
-    }
-
-
-
-    void ParseNodes(std::string& text)
-    {
-        // If there are no root nodes, just append the message and return
-        if (root_nodes.empty())
-        {
-            if (!text.empty() && text.back() != '\n')
-                text += '\n';
-
-            text += "a root node is needed";
             return;
         }
 
-        // For cycle detection and to avoid reprocessing nodes
-        std::unordered_set<Node*> visited;
-        std::unordered_set<Node*> recursionStack;
-
-        bool cycleDetected = false;
-
-        // Depth-first traversal
-        std::function<void(Node*)> dfs = [&](Node* node)
-            {
-                if (!node)
-                    return;
-
-                // Cycle detection: if the node is already in the current recursion stack
-                if (recursionStack.find(node) != recursionStack.end())
-                {
-                    cycleDetected = true;
-                    // Do not recurse further from this node to avoid infinite loop
-                    return;
-                }
-
-                // If we've already fully processed this node, skip it
-                if (visited.find(node) != visited.end())
-                    return;
-
-                visited.insert(node);
-                recursionStack.insert(node);
-
-                // Append this node's name on its own line
-                if (!text.empty() && text.back() != '\n')
-                    text += ' ';
-
-                text += node->Name;
-
-                // If this is a Constant node, treat it as a leaf and go back up
-                if (node->Type == NodeType::Constant )
-                {
-                    recursionStack.erase(node);
-                    return;
-                }
+        // Built as an empty node of the same size with pins as stripes along
+        // its edges, so pins and links follow it while it is dragged
+        ed::BeginNode(node->ID);
 
-                // Go down each output node in order (depth-first)
-                for (Node* out : node->OutputNodes)
-                {
-                    dfs(out);
-                }
+        const ImVec4 padding = ed::GetStyle().NodePadding;
+        ImGui::Dummy(ImVec2(std::max(size.x - padding.x - padding.z, 0.0f), std::max(size.y - padding.y - padding.w, 0.0f)));
 
-                // Done exploring this path
-                recursionStack.erase(node);
-            };
+        const ImVec2 min = ed::GetNodePosition(node->ID);
+        const ImVec2 max = ImVec2(min.x + size.x, min.y + size.y);
 
-        // Start DFS from each root node
-        for (Node* root : root_nodes)
+        // Keep stripes clear of rounded corners
+        const float inset = ed::GetStyle().NodeRounding;
+        float top = min.y + inset;
+        float bottom = max.y - inset;
+        if (bottom <= top)
         {
-            dfs(root);
-            text += '\n';
+            top = min.y;
+            bottom = max.y;
         }
 
-        // If a cycle was detected anywhere, note it at the end of the string
-        if (cycleDetected)
+        // Input on the left edge, outputs share the right edge
+        const bool hasInput = node->Type != NodeType::Primary && node->InputPin;
+        if (hasInput)
         {
-            if (!text.empty() && text.back() != '\n')
-                text += '\n';
-
-            text += "cycle detected";
+            ed::BeginPin(node->InputPin->ID, ed::PinKind::Input);
+            ed::PinRect(ImVec2(min.x, top), ImVec2(min.x + c_NodeLodStripeWidth, bottom));
+            ed::EndPin();
         }
-    }
-    void ParseText(const std::string& text)
-    {
-        // 0) Clear existing graph
-        for (Node* n : Nodes)
-            delete n;
-        Nodes.clear();
-        Pins.clear();
-        m_Links.clear();
-        root_nodes.clear();
 
-        uniqueId = 1;
-        m_NextLinkId = 100;
-
-        // Helper: split string into lines
-        std::vector<std::string> lines;
+        const bool hasOutputs = node->Type != NodeType::Constant && node->OutputPins.size() > 0;
+        const float step = hasOutputs ? (bottom - top) / static_cast<float>(node->OutputPins.size()) : 0.0f;
+        if (hasOutputs)
         {
-            std::string cur;
-            for (char c : text)
+            for (size_t i = 0; i < node->OutputPins.size(); ++i)
             {
-                if (c == '\n')
-                {
-                    lines.push_back(cur);
-                    cur.clear();
-                }
-                else
-                    cur.push_back(c);
+                const float y = top + step * static_cast<float>(i);
+                ed::BeginPin(node->OutputPins[i]->ID, ed::PinKind::Output);
+                ed::PinRect(ImVec2(max.x - c_NodeLodStripeWidth, y), ImVec2(max.x, y + step));
+                ed::EndPin();
             }
-            lines.push_back(cur);
         }
 
-        // Trim helper
-        auto trim = [](std::string& s)
-            {
-                size_t b = 0;
-                while (b < s.size() && std::isspace((unsigned char)s[b])) ++b;
-                size_t e = s.size();
-                while (e > b && std::isspace((unsigned char)s[e - 1])) --e;
-                s = s.substr(b, e - b);
-            };
-
-        // Tokenize a line
-        auto tokenize = [](const std::string& s) -> std::vector<std::string>
-            {
-                std::vector<std::string> out;
-                std::string cur;
-                for (char c : s)
-                {
-                    if (std::isspace((unsigned char)c))
-                    {
-                        if (!cur.empty())
-                        {
-                            out.push_back(cur);
-                            cur.clear();
-                        }
-                    }
-                    else
-                        cur.push_back(c);
-                }
-                if (!cur.empty())
-                    out.push_back(cur);
-                return out;
-            };
+        ed::EndNode();
 
-        // 1) Determine if we're in explicit-root mode
-        bool explicitRootMode = false;
-        for (auto l : lines)
-        {
-            trim(l);
-            if (l.empty()) continue;
-            auto toks = tokenize(l);
-            if (!toks.empty() && toks[0] == "Root")
-            {
-                explicitRootMode = true;
-                break;
-            }
-            else
-            {
-                // first non-empty line is not Root => implicit-root mode
-                explicitRootMode = false;
-                break;
-            }
-        }
+        ImDrawList* drawList = ed::GetNodeBackgroundDrawList(node->ID);
+        if (!drawList)
+            return;
 
-        // 2) Build graphs = vector< vector<string> >
-        std::vector<std::vector<std::string>> graphs;
+        if (hasInput)
+            drawList->AddRectFilled(ImVec2(min.x, top), ImVec2(min.x + c_NodeLodStripeWidth, bottom), GetPinColor(node->InputPin->Type));
 
-        if (!explicitRootMode)
+        if (hasOutputs)
         {
-            // All text is one graph, newlines are just whitespace
-            std::vector<std::string> all;
-            for (auto l : lines)
+            for (size_t i = 0; i < node->OutputPins.size(); ++i)
             {
-                trim(l);
-                if (l.empty()) continue;
-                auto toks = tokenize(l);
-                all.insert(all.end(), toks.begin(), toks.end());
+                const float y = top + step * static_cast<float>(i);
+                drawList->AddRectFilled(ImVec2(max.x - c_NodeLodStripeWidth, y), ImVec2(max.x, y + step), GetPinColor(node->OutputPins[i]->Type));
             }
-            if (!all.empty())
-                graphs.push_back(std::move(all));
         }
-        else
-        {
-            // Explicit-root mode: each line starting with Root begins a new graph
-            std::vector<std::string> current;
+    }
 
-            for (auto l : lines)
-            {
-                trim(l);
-                if (l.empty()) continue;
-                auto toks = tokenize(l);
-                if (toks.empty()) continue;
+    void DrawNodes(const std::vector<Node*>& nodes)
+    {
+        const bool lod = !m_FirstFrame && ed::GetCurrentZoom() > c_NodeLodZoom;
 
-                if (toks[0] == "Root")
-                {
-                    // Start new graph
-                    if (!current.empty())
-                    {
-                        graphs.push_back(std::move(current));
-                        current.clear();
-                    }
-                    // Drop the "Root" token itself, rest belong to this graph
-                    for (size_t i = 1; i < toks.size(); ++i)
-                        current.push_back(toks[i]);
-                }
-                else
-                {
-                    // Continuation of current graph (ignore newline)
-                    for (auto& t : toks)
-                        current.push_back(t);
-                }
-            }
+        for (Node* node : nodes)
+        {
+            // Off-screen nodes keep their last bounds, links and selection still work on them
+            if (!m_FirstFrame && !ed::IsNodeVisible(node->ID, c_NodeCullMargin) && ed::GhostNode(node->ID))
+                continue;
 
-            if (!current.empty())
-                graphs.push_back(std::move(current));
+            // Far out nodes keep their size, only labels and widgets are skipped
+            if (lod)
+                DrawNodeLod(node);
+            else
+                DrawNode(node);
         }
+    }
 
-        if (graphs.empty())
-            return;
-
-
-//3)
-       // a) Any function with this name (used when we don't care about overloads)
-        auto findFuncAny = [&](const std::string& name) -> const function*
-            {
-                for (const auto& f : funcs)
-                    if (f.Name == name)
-                        return &f;
-                return nullptr;
-            };
-
-        // b) Overload-aware: pick function whose input matches `expected` if possible
-        auto findFunc = [&](const std::string& name, PinType expected) -> const function*
-            {
-                const function* fallback = nullptr;
-
-                for (const auto& f : funcs)
-                {
-                    if (f.Name != name)
-                        continue;
-
-                    // Perfect match: same name + same input type
-                    if (f.input == expected)
-                        return &f;
-
-                    // Remember the first function with that name as a fallback
-                    if (!fallback)
-                        fallback = &f;
-                }
-
-                return fallback; // may be nullptr if name not found, or "closest" one
-            };
-
-
-        // 4) Recursive expression parser
 
 
-        // 4) Recursive expression parser
-        std::function<Node* (const std::vector<std::string>&, size_t&, PinType)> ParseExpr =
-            [&](const std::vector<std::string>& toks, size_t& idx, PinType expected) -> Node*
-            {
-                if (idx >= toks.size())
-                {
-                    g_TextToParse += "\nerror: unexpected end of input while expecting ";
-                    g_TextToParse += PinTypeToString(expected);
-                    return nullptr;
-                }
+    void ParseText(const std::string& text)
+    {
+        ed::SetCurrentEditor(m_Context);
 
-                const std::string& tok = toks[idx++];
-                const function* f = findFunc(tok, expected);
+        // Blocks whose text did not change are kept, remember where the user moved their nodes
+        for (Node* n : Nodes)
+        {
+            ImVec2 pos = ed::GetNodePosition(n->ID);
+            if (pos.x != FLT_MAX)
+                n->Start_pos = pos;
+        }
 
-                if (f)
-                {
-                    //    Parent's output (expected) must flow into f->input.
-                    if (CanConnectPinTypes(/*inputType=*/f->input, /*outputType=*/expected))
-                    {
-                        Node* node = NodeFromFunciton(*f, ImVec2(0, 0));
-                        if (!node) return nullptr;
+        std::string diagnostics;
+        ParseTextResult result = AbilityGraph::ParseText(text, diagnostics);
+        g_TextToParse += diagnostics;
 
-                        for (int p = 0; p < f->output_size; ++p)
-                        {
-                            Node* child = ParseExpr(toks, idx, f->output[p]);
-                            if (!child)
-                                return node; // keep partial graph, error already reported
-
-                            node->OutputNodes[p] = child;
-                            child->InputNode = node;
-
-                            m_Links.push_back({
-                                ed::LinkId(m_NextLinkId++),
-                                child->InputPin->ID,
-                                node->OutputPins[p]->ID
-                                });
-                        }
+        for (Node* n : result.CreatedNodes)
+            ed::SetNodePosition(n->ID, n->Start_pos);
+    }
 
-                        return node;
-                    }
 
-                    // 2) Relaxed rule: if this function takes Trigger as input,
-                    //    and we couldn't connect it, treat token as a constant of `expected`.
-                    if (f->input == PinType::Trigger)
-                    {
-                        Node* c = MakeBasicNode(
-                            tok,
-                            expected,  // "matching constant of the previous type"
-                            {},
-                            ImVec2(0, 0),
-                            "",
-                            NodeType::Constant
-                        );
-                        return c;
-                    }
 
-                    // 3) Genuine type mismatch
-                    g_TextToParse += "\nerror: type mismatch at token '";
-                    g_TextToParse += tok;
-                    g_TextToParse += "': function expects ";
-                    g_TextToParse += PinTypeToString(f->input);
-                    g_TextToParse += " but parent needed ";
-                    g_TextToParse += PinTypeToString(expected);
-                    return nullptr;
-                }
-                else
-                {
-                    // No function with that name at all -> constant of expected type
-                    Node* c = MakeBasicNode(tok, expected, {}, ImVec2(0, 0), "", NodeType::Constant);
-                    return c;
-                }
-            };
 
-      // 5) Parse each graph, create Primary Root
-        for (auto& g : graphs)
+    Example(const char* name, int argc, char** argv)
+        : Application(name, argc, argv)
+    {
+        // Loading ability text at start lets --headless runs work on real
+        // graphs, synthetic input cannot type one in
+        for (int i = 1; i + 1 < argc; ++i)
         {
-            if (g.empty())
-                continue;
-
-            // Infer root output type from first token if possible
-            PinType rootOutputType = PinType::Trigger;
-            if (!g.empty())
-            {
-                if (const function* f0 = findFuncAny(g[0]))
-                    rootOutputType = f0->input;
-            }
-
-            // Create primary root node; MakeBasicNode will add it to root_nodes
-            Node* root = MakeBasicNode(
-                "Root",
-                PinType::Action,         // dummy input
-                { rootOutputType },      // one output
-                ImVec2(0, 0),
-                "",
-                NodeType::Primary
-            );
-
-            size_t idx = 0;
-            Node* child = ParseExpr(g, idx, rootOutputType);
-
-            if (child)
-            {
-                root->OutputNodes[0] = child;
-                child->InputNode = root;
-
-                m_Links.push_back({
-                    ed::LinkId(m_NextLinkId++),
-                    child->InputPin->ID,
-                    root->OutputPins[0]->ID
-                    });
-            }
-
-            if (idx < g.size())
-            {
-                g_TextToParse += "\nwarning: extra tokens at end of line starting with '";
-                g_TextToParse += g[0];
-                g_TextToParse += "'";
-            }
+            if (!std::strcmp(argv[i], "--modinfo"))
+                m_ModInfoPath = argv[++i];
+            else if (!std::strcmp(argv[i], "--text"))
+                m_TextPath = argv[++i];
         }
-
-        AutoLayoutGraphs();
-        ed::SetCurrentEditor(m_Context);
-        for (Node* n : Nodes)
-            ed::SetNodePosition(n->ID, n->Start_pos);
     }
 
+    void LoadText(const char* path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::fprintf(stderr, "error: cannot read '%s'\n", path);
+            return;
+        }
 
-
-
-
-    using Application::Application;
+        g_TextToParse.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        ParseText(g_TextToParse);
+    }
 
     void OnStart() override
     {
         ed::Config config;
         config.SettingsFile = "BasicInteraction.json";
+        config.EnableProfiler = true;
+        config.SettingsSaveDelay = 0.5f;
+        config.EnableAsyncSettingsSave = true;
         m_Context = ed::CreateEditor(&config);
 
-        ParseModInfo(funcs);
-        ;
+        // Draw only on input, editor asks for more frames while it animates
+        SetIdleMode(true);
+
+        ParseModInfo(funcs, m_ModInfoPath.c_str());
+        Catalog = &funcs;
+
+        if (!m_TextPath.empty())
+            LoadText(m_TextPath.c_str());
     }
 
     void OnStop() override
@@ -871,6 +365,14 @@ struct Example :
 
         ImGui::Text("FPS: %.2f (%.2gms)", io.Framerate, io.Framerate ? 1000.0f / io.Framerate : 0.0f);
 
+        // Open in chrome://tracing or Perfetto to see which part of the editor is slow
+        ImGui::SameLine();
+        if (ImGui::Button("Save Trace"))
+        {
+            ed::SetCurrentEditor(m_Context);
+            ed::SaveProfilerTrace("BasicInteraction.trace.json");
+        }
+
         ImGui::Separator();
 
         //window with textbox
@@ -983,10 +485,7 @@ struct Example :
         // Submit Links
         for (auto& linkInfo : m_Links)
         {
-            Pin* outputPin = nullptr;
-            for (Pin* p : Pins)
-                if (p->ID == linkInfo.OutputId)
-                    outputPin = p;
+            Pin* outputPin = FindPin(linkInfo.OutputId);
 
             ImVec4 color = GetPinColor(outputPin ? outputPin->Type : PinType::Trigger);
 
@@ -1030,32 +529,27 @@ struct Example :
 
                 PinType Atype;
                 PinType Btype;
-                for (Pin* pin : Pins)
+                if (Pin* pin = FindPin(InputPinId))
                 {
-                    if (Aisinput && Bisinput) { break; }
-
-                    if (pin->ID == InputPinId)
+                    Atype = pin->Type;
+                    n1 = pin->NodePtr;
+                    if (pin->Kind == PinKind::Input)
                     {
-                        Atype = pin->Type;
-                        n1 = pin->NodePtr;
-                        if (pin->Kind == PinKind::Input)
-                        {
-                            Aisinput = true;
-                            actual_input_pin = pin->ID;
-                        }
-
+                        Aisinput = true;
+                        actual_input_pin = pin->ID;
                     }
-                    if (pin->ID == OutputPinId)
-                    {
-                        Btype = pin->Type;
-                        n2 = pin->NodePtr;
-                        if (pin->Kind == PinKind::Input)
-                        {
-                            Bisinput = true;
-                            actual_input_pin = pin->ID;
-                        }
 
+                }
+                if (Pin* pin = FindPin(OutputPinId))
+                {
+                    Btype = pin->Type;
+                    n2 = pin->NodePtr;
+                    if (pin->Kind == PinKind::Input)
+                    {
+                        Bisinput = true;
+                        actual_input_pin = pin->ID;
                     }
+
                 }
                 PinType inputType;
                 PinType outputType;
@@ -1097,6 +591,10 @@ struct Example :
                         }
                         input_node->InputNode = output_node; //very spaghetti but should work
 
+                        // Graph no longer matches the text of these blocks
+                        MarkDirty(input_node);
+                        MarkDirty(output_node);
+
                         // Since we accepted new link, lets add one to our list of links.
                         m_Links.push_back({ ed::LinkId(m_NextLinkId++), InputPinId, OutputPinId });
 
@@ -1132,15 +630,9 @@ struct Example :
                     if (link.Id != deletedLinkId)
                         continue;
 
-                    Pin* input_pin = nullptr;
-                    Pin* output_pin = nullptr;
-
                     // Find the two pins
-                    for (Pin* pin : Pins)
-                    {
-                        if (link.InputId == pin->ID) input_pin = pin;
-                        if (link.OutputId == pin->ID) output_pin = pin;
-                    }
+                    Pin* input_pin = FindPin(link.InputId);
+                    Pin* output_pin = FindPin(link.OutputId);
 
                     // Make sure input_pin is actually an Input and output_pin an Output
                     if (input_pin && input_pin->Kind == PinKind::Output)
@@ -1149,6 +641,9 @@ struct Example :
                     Node* input_node = input_pin ? input_pin->NodePtr : nullptr;
                     Node* output_node = output_pin ? output_pin->NodePtr : nullptr;
 
+                    MarkDirty(input_node);
+                    MarkDirty(output_node);
+
                     // Clear the child's InputNode
                     if (input_node)
                         input_node->InputNode = nullptr;
@@ -1179,25 +674,8 @@ struct Example :
                 {
 
 
-                    for (size_t i = 0; i < Nodes.size(); ++i) {
-                        Node* node = Nodes[i];
-
-                        if (node->ID == DeletedNode) {
-
-                            if (node->Type == NodeType::Primary)
-                            {
-                                for (size_t k = 0; k < root_nodes.size(); ++k)
-                                {
-                                    root_nodes.erase(root_nodes.begin() + k);
-                                }
-                            }
-
-                            node->RemovePinsFrom(Pins);
-                            delete node;
-                            Nodes.erase(Nodes.begin() + i);
-                            --i;
-                        }
-                    }
+                    // Memory is owned by the block arena and released when the block is rebuilt
+                    RemoveNode(FindNode(DeletedNode));
                 }
             }
         
@@ -1213,26 +691,18 @@ struct Example :
 
         if (auto hoveredId = ed::GetHoveredNode())
         {
-            Node* hoveredNode = nullptr;
-            for (Node* n : Nodes)
-            {
-                if (n->ID == hoveredId)
-                {
-                    hoveredNode = n;
-                    break;
-                }
-            }
+            Node* hoveredNode = FindNode(hoveredId);
 
-            if (hoveredNode && !hoveredNode->description.empty())
+            if (hoveredNode && hoveredNode->description[0] != '\0')
             {
                 ImGui::BeginTooltip();
-                ImGui::TextUnformatted(hoveredNode->Name.c_str());
+                ImGui::TextUnformatted(hoveredNode->Name);
                 ImGui::Separator();
 
                 // Fix: manually choose wrap width (e.g. 40 characters-ish)
                 float wrapWidth = ImGui::GetFontSize() * 40.0f;
                 ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + wrapWidth);
-                ImGui::TextUnformatted(hoveredNode->description.c_str());
+                ImGui::TextUnformatted(hoveredNode->description);
                 ImGui::PopTextWrapPos();
 
                 ImGui::EndTooltip();
@@ -1402,63 +872,43 @@ struct Example :
                 ImVec2 avail = ImGui::GetContentRegionAvail();
                 ImGui::BeginChild("##FunctionList", avail, true);
 
-                const std::string prefix = m_CreateNodeFilter;
-                for (std::size_t i = 0; i < funcs.size(); ++i)
-                {
-                    const function& f = funcs[i];
+                // Filtered list is only rebuilt when a filter changes
+                if (m_CreateNodeResultsType != m_CreateNodeTypeFilter || m_CreateNodeResultsFilter != m_CreateNodeFilter)
+                    UpdateCreateNodeResults();
 
-                    // Type filter
-                    if (m_CreateNodeTypeFilter != 0)
-                    {
-                        PinType expected = allTypes[m_CreateNodeTypeFilter - 1].type;
-                        if (f.input != expected)
-                            continue;
-                    }
+                int clickedIndex = -1;
 
-                    // Name prefix filter (case-insensitive)
-                    if (!prefix.empty() && !StartsWithCaseInsensitive(f.Name, prefix))
-                        continue;
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(m_CreateNodeResults.size()));
+                while (clipper.Step())
+                {
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+                    {
+                        const int i = m_CreateNodeResults[row];
+                        const function& f = funcs[i];
 
-                    ImGui::PushID(static_cast<int>(i));
+                        ImGui::PushID(i);
 
-                    // Main selectable: function name
-                    bool clicked = ImGui::Selectable(f.Name.c_str());
+                        // Main selectable: function name
+                        if (ImGui::Selectable(f.Name.data()))
+                            clickedIndex = i;
 
-                    // Build inline signature: "InputType -> Out1, Out2" / "InputType -> void"
-                    std::string sig;
-                    sig += PinTypeToString(f.input);
-                    sig += " -> ";
+                        // Draw signature on same line, dimmer as secondary text
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("%s", funcs.Signature(i));
 
-                    if (f.output_size <= 0)
-                    {
-                        sig += "void";
-                    }
-                    else
-                    {
-                        for (int oi = 0; oi < f.output_size; ++oi)
-                        {
-                            if (oi > 0)
-                                sig += ", ";
-                            sig += PinTypeToString(f.output[oi]);
-                        }
+                        ImGui::PopID();
                     }
+                }
 
-                    // Draw signature on same line, dimmer as secondary text
-                    ImGui::SameLine();
-                    ImGui::TextDisabled("%s", sig.c_str());
-
-                    ImGui::PopID();
-
-                    if (clicked)
-                    {
-                        // Create node at stored canvas position
-                        Node* created = NodeFromFunciton(f, m_CreateNodePosCanvas);
-                        if (created)
-                            ed::SetNodePosition(created->ID, m_CreateNodePosCanvas);
+                if (clickedIndex >= 0)
+                {
+                    // Create node at stored canvas position
+                    Node* created = NodeFromFunciton(funcs[clickedIndex], m_CreateNodePosCanvas);
+                    if (created)
+                        ed::SetNodePosition(created->ID, m_CreateNodePosCanvas);
 
-                        m_ShowCreateNode = false;
-                        break;
-                    }
+                    m_ShowCreateNode = false;
                 }
 
                 ImGui::EndChild();
@@ -1478,6 +928,11 @@ struct Example :
         if (m_FirstFrame)
             ed::NavigateToContent(0.0f);
 
+        if (ed::NeedsFrame())
+            RequestFrame();
+        else if (ed::GetSettingsSaveTimeout() >= 0.0f)
+            RequestFrame(ed::GetSettingsSaveTimeout());
+
         ed::SetCurrentEditor(nullptr);
 
         m_FirstFrame = false;
@@ -1487,8 +942,6 @@ struct Example :
 
     ed::EditorContext* m_Context = nullptr;    // Editor context, required to trace a editor state.
     bool                 m_FirstFrame = true;    // Flag set for first frame only, some action need to be executed once.
-    ImVector<LinkInfo>   m_Links;                // List of live links. It is dynamic unless you want to create read-only view over nodes.
-    int                  m_NextLinkId = 100;     // Counter to help generate link ids. In real application this will probably based on pointer to user data structure.
 };
 
 int Main(int argc, char** argv)
@@ -0,0 +1,536 @@
+// chaosnode-bench
+//
+// Benchmarks for the headless text <-> graph core. A synthetic catalog and
+// ability text are generated from the options below, then every stage the
+// editor runs is timed on them. Results are written to stdout as JSON lines,
+// one object per benchmark, so runs can be diffed or collected by scripts.
+//
+//   chaosnode-bench [options]
+//
+// Allocation counts come from replacing the global operator new/delete in
+// this executable, peak memory is the process' peak resident set.
+
+#include <AbilityGraph.h>
+#include <AbilityWriter.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+
+//------------------------------------------------------------------------------
+// Allocation tracking
+
+// Every block carries its size in front of it so delete can keep the live
+// byte count. 16 bytes keep the default new alignment.
+static const size_t c_AllocHeader = 16;
+
+static std::atomic<size_t> g_AllocCount{ 0 };
+static std::atomic<size_t> g_AllocBytes{ 0 };
+static std::atomic<size_t> g_LiveBytes{ 0 };
+static std::atomic<size_t> g_PeakLiveBytes{ 0 };
+
+static void* TrackedAlloc(size_t size)
+{
+    char* block = static_cast<char*>(std::malloc(size + c_AllocHeader));
+    if (!block)
+        throw std::bad_alloc();
+
+    std::memcpy(block, &size, sizeof(size));
+
+    g_AllocCount.fetch_add(1, std::memory_order_relaxed);
+    g_AllocBytes.fetch_add(size, std::memory_order_relaxed);
+    const size_t live = g_LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    size_t peak = g_PeakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_PeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+
+    return block + c_AllocHeader;
+}
+
+static void TrackedFree(void* memory)
+{
+    if (!memory)
+        return;
+
+    char* block = static_cast<char*>(memory) - c_AllocHeader;
+
+    size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    g_LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+
+    std::free(block);
+}
+
+void* operator new(size_t size)                          { return TrackedAlloc(size); }
+void* operator new[](size_t size)                        { return TrackedAlloc(size); }
+void  operator delete(void* memory) noexcept             { TrackedFree(memory); }
+void  operator delete[](void* memory) noexcept           { TrackedFree(memory); }
+void  operator delete(void* memory, size_t) noexcept     { TrackedFree(memory); }
+void  operator delete[](void* memory, size_t) noexcept   { TrackedFree(memory); }
+
+static size_t PeakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#   ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#   else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// Options
+
+struct Options
+{
+    int         Functions = 2000;       // catalog entries
+    int         Roots = 5000;           // Root lines in the ability text
+    int         Depth = 6;              // max nesting below each root
+    int         FanOut = 3;             // max outputs per function
+    int         Iterations = 10;
+    unsigned    Seed = 1;
+    std::string WorkDir;                // where the synthetic catalog is written
+};
+
+static void PrintUsage()
+{
+    std::fprintf(stderr,
+        "usage: chaosnode-bench [options]\n"
+        "\n"
+        "  -f, --functions <n>   functions in the synthetic catalog (default: 2000)\n"
+        "  -r, --roots <n>       Root lines in the synthetic ability text (default: 5000)\n"
+        "  -d, --depth <n>       max nesting depth below a root (default: 6)\n"
+        "  -w, --fan-out <n>     max outputs per function, at most 10 (default: 3)\n"
+        "  -n, --iterations <n>  timed runs per benchmark (default: 10)\n"
+        "  -s, --seed <n>        random seed (default: 1)\n"
+        "  -t, --work-dir <dir>  directory for the generated catalog (default: system temp)\n");
+}
+
+static bool ParseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        auto value = [&]() -> const char*
+            {
+                if (i + 1 >= argc)
+                {
+                    std::fprintf(stderr, "error: missing value for %s\n", arg);
+                    return nullptr;
+                }
+                return argv[++i];
+            };
+
+        auto number = [&](int& out) -> bool
+            {
+                auto v = value(); if (!v) return false;
+                out = std::atoi(v);
+                return true;
+            };
+
+        if (!std::strcmp(arg, "-f") || !std::strcmp(arg, "--functions"))
+        {
+            if (!number(options.Functions)) return false;
+        }
+        else if (!std::strcmp(arg, "-r") || !std::strcmp(arg, "--roots"))
+        {
+            if (!number(options.Roots)) return false;
+        }
+        else if (!std::strcmp(arg, "-d") || !std::strcmp(arg, "--depth"))
+        {
+            if (!number(options.Depth)) return false;
+        }
+        else if (!std::strcmp(arg, "-w") || !std::strcmp(arg, "--fan-out"))
+        {
+            if (!number(options.FanOut)) return false;
+        }
+        else if (!std::strcmp(arg, "-n") || !std::strcmp(arg, "--iterations"))
+        {
+            if (!number(options.Iterations)) return false;
+        }
+        else if (!std::strcmp(arg, "-s") || !std::strcmp(arg, "--seed"))
+        {
+            auto v = value(); if (!v) return false;
+            options.Seed = static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+        }
+        else if (!std::strcmp(arg, "-t") || !std::strcmp(arg, "--work-dir"))
+        {
+            auto v = value(); if (!v) return false;
+            options.WorkDir = v;
+        }
+        else if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help"))
+            return false;
+        else
+        {
+            std::fprintf(stderr, "error: unknown option %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.Functions < 1 || options.Roots < 1 || options.Depth < 0 || options.Iterations < 1
+        || options.FanOut < 0 || options.FanOut > 10)
+    {
+        std::fprintf(stderr, "error: option out of range\n");
+        return false;
+    }
+
+    return true;
+}
+
+
+//------------------------------------------------------------------------------
+// Synthetic input
+
+// ModdingInfo.txt with `Functions` entries spread over all pin types, each
+// with 0..FanOut outputs of random type.
+static std::string GenerateCatalogText(const Options& options, std::mt19937& random)
+{
+    std::uniform_int_distribution<int> outputCount(0, options.FanOut);
+    std::uniform_int_distribution<int> pinType(0, PinTypeCount - 1);
+
+    std::string text = "Modding Info\n";
+    for (int type = 0; type < PinTypeCount; ++type)
+    {
+        text += '\n';
+        text += PinTypeToString(static_cast<PinType>(type));
+        text += ":\n";
+
+        for (int i = type; i < options.Functions; i += PinTypeCount)
+        {
+            text += "Fn";
+            text += std::to_string(i);
+
+            for (int o = outputCount(random); o > 0; --o)
+            {
+                text += ' ';
+                text += PinTypeToString(static_cast<PinType>(pinType(random)));
+            }
+
+            text += "     \"Synthetic function ";
+            text += std::to_string(i);
+            text += " \"\n";
+        }
+    }
+
+    return text;
+}
+
+// One Root line per root, each a random well typed expression. Functions are
+// picked by input type so the text parses without diagnostics; below Depth,
+// or for types nothing takes, a number constant closes the branch.
+static std::string GenerateAbilityText(const Options& options, const FunctionCatalog& catalog, std::mt19937& random)
+{
+    std::uniform_int_distribution<int> constant(0, 99);
+
+    struct Pending
+    {
+        PinType Type;
+        int     Depth;
+    };
+    std::vector<Pending> stack;
+
+    std::string text;
+    for (int root = 0; root < options.Roots; ++root)
+    {
+        text += "Root";
+
+        const function& first = catalog[random() % catalog.size()];
+        stack.push_back({ first.input, 0 });
+
+        while (!stack.empty())
+        {
+            const Pending expr = stack.back();
+            stack.pop_back();
+
+            text += ' ';
+
+            const std::vector<int>& candidates = catalog.WithInput(expr.Type);
+            if (expr.Depth >= options.Depth || candidates.empty())
+            {
+                text += std::to_string(constant(random));
+                continue;
+            }
+
+            const function& f = catalog[candidates[random() % candidates.size()]];
+            text += f.Name;
+
+            // Children are written in output order, so push them reversed
+            for (int o = f.output_size - 1; o >= 0; --o)
+                stack.push_back({ f.output[o], expr.Depth + 1 });
+        }
+
+        text += '\n';
+    }
+
+    return text;
+}
+
+
+//------------------------------------------------------------------------------
+// Measuring
+
+struct Sample
+{
+    double Seconds;
+    size_t Allocations;
+    size_t AllocatedBytes;
+    size_t PeakHeapBytes;       // above the live heap when the run started
+};
+
+struct Result
+{
+    const char*         Name;
+    std::vector<Sample> Samples;
+    double              Items = 0;          // processed per run, for throughput
+    const char*         ItemName = "items";
+    double              Bytes = 0;          // processed per run, 0 if not meaningful
+};
+
+// Time `run` Iterations times, calling `setup` untimed before each run.
+template <typename Setup, typename Run>
+static Result Measure(const char* name, const Options& options, Setup&& setup, Run&& run)
+{
+    Result result;
+    result.Name = name;
+    result.Samples.reserve(options.Iterations);
+
+    for (int i = 0; i < options.Iterations; ++i)
+    {
+        setup();
+
+        const size_t allocCount = g_AllocCount.load();
+        const size_t allocBytes = g_AllocBytes.load();
+        const size_t liveBytes = g_LiveBytes.load();
+        g_PeakLiveBytes.store(liveBytes);
+
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto stop = std::chrono::steady_clock::now();
+
+        Sample sample;
+        sample.Seconds = std::chrono::duration<double>(stop - start).count();
+        sample.Allocations = g_AllocCount.load() - allocCount;
+        sample.AllocatedBytes = g_AllocBytes.load() - allocBytes;
+        sample.PeakHeapBytes = g_PeakLiveBytes.load() - liveBytes;
+        result.Samples.push_back(sample);
+    }
+
+    return result;
+}
+
+static void PrintResult(const Result& result)
+{
+    std::vector<double> seconds;
+    seconds.reserve(result.Samples.size());
+    size_t allocations = 0, allocatedBytes = 0, peakHeapBytes = 0;
+    for (const auto& sample : result.Samples)
+    {
+        seconds.push_back(sample.Seconds);
+        allocations = std::max(allocations, sample.Allocations);
+        allocatedBytes = std::max(allocatedBytes, sample.AllocatedBytes);
+        peakHeapBytes = std::max(peakHeapBytes, sample.PeakHeapBytes);
+    }
+    std::sort(seconds.begin(), seconds.end());
+
+    const double best = seconds.front();
+    const double median = seconds[seconds.size() / 2];
+
+    std::printf("{\"benchmark\":\"%s\",\"iterations\":%zu,\"min_ns\":%.0f,\"median_ns\":%.0f,\"max_ns\":%.0f,"
+        "\"%s\":%.0f,\"%s_per_second\":%.0f,",
+        result.Name, seconds.size(), best * 1e9, median * 1e9, seconds.back() * 1e9,
+        result.ItemName, result.Items, result.ItemName, median > 0 ? result.Items / median : 0.0);
+
+    if (result.Bytes > 0)
+        std::printf("\"bytes\":%.0f,\"bytes_per_second\":%.0f,", result.Bytes, median > 0 ? result.Bytes / median : 0.0);
+
+    std::printf("\"allocations\":%zu,\"allocated_bytes\":%zu,\"peak_heap_bytes\":%zu}\n",
+        allocations, allocatedBytes, peakHeapBytes);
+}
+
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::mt19937 random(options.Seed);
+
+    std::error_code ec;
+    const fs::path workDir = options.WorkDir.empty() ? fs::temp_directory_path(ec) : fs::path(options.WorkDir);
+    const fs::path catalogPath = workDir / ("chaosnode-bench-" + std::to_string(options.Seed) + ".txt");
+    const std::string catalogFile = catalogPath.string();
+    const std::string cacheFile = catalogFile + ".cache";
+
+    const std::string catalogText = GenerateCatalogText(options, random);
+    {
+        std::ofstream file(catalogPath, std::ios::binary | std::ios::trunc);
+        file.write(catalogText.data(), static_cast<std::streamsize>(catalogText.size()));
+        if (!file)
+        {
+            std::fprintf(stderr, "error: cannot write %s\n", catalogFile.c_str());
+            return 2;
+        }
+    }
+
+    FunctionCatalog catalog;
+    if (!ParseModInfo(catalog, catalogFile.c_str(), /*useCache=*/false))
+    {
+        std::fprintf(stderr, "error: cannot read %s\n", catalogFile.c_str());
+        return 2;
+    }
+
+    const std::string abilityText = GenerateAbilityText(options, catalog, random);
+
+    // Reference numbers for throughput and a sanity check of the generator
+    AbilityGraph graph;
+    graph.Catalog = &catalog;
+
+    std::string diagnostics;
+    graph.ParseText(abilityText, diagnostics);
+    if (!diagnostics.empty())
+    {
+        std::fprintf(stderr, "error: generated text does not parse:%s\n", diagnostics.substr(0, 500).c_str());
+        return 1;
+    }
+
+    std::vector<AbilityToken> tokens;
+    TokenizeAbilityText(abilityText, tokens);
+
+    const double tokenCount = static_cast<double>(tokens.size());
+    const double nodeCount = static_cast<double>(graph.Nodes.size());
+
+    std::printf("{\"config\":{\"functions\":%d,\"roots\":%d,\"depth\":%d,\"fan_out\":%d,\"iterations\":%d,\"seed\":%u,"
+        "\"catalog_bytes\":%zu,\"text_bytes\":%zu,\"tokens\":%zu,\"nodes\":%zu}}\n",
+        options.Functions, options.Roots, options.Depth, options.FanOut, options.Iterations, options.Seed,
+        catalogText.size(), abilityText.size(), tokens.size(), graph.Nodes.size());
+
+    std::vector<Result> results;
+
+    {
+        FunctionCatalog target;
+        auto result = Measure("ParseModInfo", options, []() {},
+            [&]() { ParseModInfo(target, catalogFile.c_str(), /*useCache=*/false); });
+        result.Items = static_cast<double>(target.size());
+        result.ItemName = "functions";
+        result.Bytes = static_cast<double>(catalogText.size());
+        results.push_back(std::move(result));
+
+        // First load writes the cache, the timed ones map it
+        ParseModInfo(target, catalogFile.c_str(), /*useCache=*/true);
+        result = Measure("ParseModInfo/cached", options, []() {},
+            [&]() { ParseModInfo(target, catalogFile.c_str(), /*useCache=*/true); });
+        result.Items = static_cast<double>(target.size());
+        result.ItemName = "functions";
+        result.Bytes = static_cast<double>(catalogText.size());
+        results.push_back(std::move(result));
+    }
+
+    {
+        auto result = Measure("ParseText", options,
+            [&]() { graph.Clear(); diagnostics.clear(); },
+            [&]() { graph.ParseText(abilityText, diagnostics); });
+        result.Items = tokenCount;
+        result.ItemName = "tokens";
+        result.Bytes = static_cast<double>(abilityText.size());
+        results.push_back(std::move(result));
+
+        // Nothing changed, every Root block is kept
+        result = Measure("ParseText/unchanged", options,
+            [&]() { diagnostics.clear(); },
+            [&]() { graph.ParseText(abilityText, diagnostics); });
+        result.Items = tokenCount;
+        result.ItemName = "tokens";
+        result.Bytes = static_cast<double>(abilityText.size());
+        results.push_back(std::move(result));
+    }
+
+    {
+        std::string text;
+        AbilityTextWriter writer;
+        auto result = Measure("ParseNodes", options,
+            [&]() { text.clear(); text.shrink_to_fit(); },
+            [&]() { graph.ParseNodes(text, writer); });
+        result.Items = nodeCount;
+        result.ItemName = "nodes";
+        result.Bytes = static_cast<double>(text.size());
+        results.push_back(std::move(result));
+    }
+
+    {
+        auto result = Measure("AutoLayoutGraphs", options, []() {},
+            [&]() { graph.AutoLayoutGraphs(); });
+        result.Items = nodeCount;
+        result.ItemName = "nodes";
+        results.push_back(std::move(result));
+    }
+
+    {
+        const int rounds = 10000;
+        volatile int connectable = 0;
+        auto result = Measure("CanConnectPinTypes", options, []() {},
+            [&]()
+            {
+                int count = 0;
+                for (int r = 0; r < rounds; ++r)
+                    for (int in = 0; in < PinTypeCount; ++in)
+                        for (int out = 0; out < PinTypeCount; ++out)
+                            count += CanConnectPinTypes(static_cast<PinType>(in), static_cast<PinType>(out));
+                connectable = count;
+            });
+        result.Items = static_cast<double>(rounds) * PinTypeCount * PinTypeCount;
+        result.ItemName = "checks";
+        results.push_back(std::move(result));
+    }
+
+    for (const auto& result : results)
+        PrintResult(result);
+
+    std::printf("{\"peak_resident_bytes\":%zu}\n", PeakResidentBytes());
+
+    fs::remove(catalogPath, ec);
+    fs::remove(cacheFile, ec);
+
+    return 0;
+}
@@ -0,0 +1,349 @@
+// chaosnode-cli
+//
+// Headless batch converter for CubeChaos ability files. Every input file is
+// parsed into a graph (text -> nodes) and written back out (nodes -> text)
+// with the same code the editor uses for its "Parse text" / "Parse nodes"
+// buttons. Files are processed in parallel on a small worker pool.
+//
+//   chaosnode-cli [options] <file-or-directory>...
+//
+// Without -o / -i files are only validated. Files with diagnostics are never
+// written. Exit code is 1 if any file produced diagnostics, 2 on usage or
+// I/O errors.
+
+#include <AbilityGraph.h>
+#include <AbilityWriter.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Options
+{
+    std::string              ModInfo = "ModdingInfo.txt";
+    std::string              Extension = ".txt";
+    std::string              OutDir;
+    bool                     InPlace = false;
+    bool                     StripRoot = false;
+    bool                     Quiet = false;
+    unsigned                 Jobs = 0;
+    std::vector<std::string> Inputs;
+};
+
+struct FileJob
+{
+    fs::path    Path;
+    fs::path    Relative;       // path relative to the input root, used for --out
+    std::string Diagnostics;
+    std::string Output;
+    bool        IoError = false;
+};
+
+static void PrintUsage()
+{
+    std::fprintf(stderr,
+        "usage: chaosnode-cli [options] <file-or-directory>...\n"
+        "\n"
+        "  -m, --modinfo <file>  function catalog (default: ModdingInfo.txt)\n"
+        "  -e, --ext <ext>       extension of ability files in directories (default: .txt)\n"
+        "  -o, --out <dir>       write normalized text into <dir>, mirroring the input layout\n"
+        "  -i, --in-place        rewrite input files with normalized text\n"
+        "  -r, --strip-root      omit the editor-only 'Root' keyword from written text\n"
+        "  -j, --jobs <n>        number of worker threads (default: all cores)\n"
+        "  -q, --quiet           only report files with diagnostics\n");
+}
+
+static bool ParseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        auto value = [&]() -> const char*
+            {
+                if (i + 1 >= argc)
+                {
+                    std::fprintf(stderr, "error: missing value for %s\n", arg);
+                    return nullptr;
+                }
+                return argv[++i];
+            };
+
+        if (!std::strcmp(arg, "-m") || !std::strcmp(arg, "--modinfo"))
+        {
+            auto v = value(); if (!v) return false;
+            options.ModInfo = v;
+        }
+        else if (!std::strcmp(arg, "-e") || !std::strcmp(arg, "--ext"))
+        {
+            auto v = value(); if (!v) return false;
+            options.Extension = v;
+            if (!options.Extension.empty() && options.Extension[0] != '.')
+                options.Extension.insert(options.Extension.begin(), '.');
+        }
+        else if (!std::strcmp(arg, "-o") || !std::strcmp(arg, "--out"))
+        {
+            auto v = value(); if (!v) return false;
+            options.OutDir = v;
+        }
+        else if (!std::strcmp(arg, "-j") || !std::strcmp(arg, "--jobs"))
+        {
+            auto v = value(); if (!v) return false;
+            options.Jobs = static_cast<unsigned>(std::strtoul(v, nullptr, 10));
+        }
+        else if (!std::strcmp(arg, "-i") || !std::strcmp(arg, "--in-place"))
+            options.InPlace = true;
+        else if (!std::strcmp(arg, "-r") || !std::strcmp(arg, "--strip-root"))
+            options.StripRoot = true;
+        else if (!std::strcmp(arg, "-q") || !std::strcmp(arg, "--quiet"))
+            options.Quiet = true;
+        else if (!std::strcmp(arg, "-h") || !std::strcmp(arg, "--help"))
+            return false;
+        else if (arg[0] == '-' && arg[1] != '\0')
+        {
+            std::fprintf(stderr, "error: unknown option %s\n", arg);
+            return false;
+        }
+        else
+            options.Inputs.push_back(arg);
+    }
+
+    if (options.Inputs.empty())
+        return false;
+
+    if (options.InPlace && !options.OutDir.empty())
+    {
+        std::fprintf(stderr, "error: --in-place and --out are mutually exclusive\n");
+        return false;
+    }
+
+    return true;
+}
+
+// Expand inputs into a flat, sorted list of files.
+static bool CollectFiles(const Options& options, std::vector<FileJob>& jobs)
+{
+    std::error_code ec;
+    const fs::path modInfo = fs::weakly_canonical(options.ModInfo, ec);
+
+    for (const auto& input : options.Inputs)
+    {
+        fs::path root = input;
+
+        if (fs::is_regular_file(root, ec))
+        {
+            FileJob job;
+            job.Path = root;
+            job.Relative = root.filename();
+            jobs.push_back(std::move(job));
+            continue;
+        }
+
+        if (!fs::is_directory(root, ec))
+        {
+            std::fprintf(stderr, "error: %s: no such file or directory\n", input.c_str());
+            return false;
+        }
+
+        std::vector<FileJob> found;
+        for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (!it->is_regular_file(ec) || it->path().extension() != options.Extension)
+                continue;
+
+            // Catalog often lives next to the abilities, never treat it as one.
+            if (fs::weakly_canonical(it->path(), ec) == modInfo)
+                continue;
+
+            FileJob job;
+            job.Path = it->path();
+            job.Relative = it->path().lexically_relative(root);
+            found.push_back(std::move(job));
+        }
+
+        if (ec)
+        {
+            std::fprintf(stderr, "error: %s: %s\n", input.c_str(), ec.message().c_str());
+            return false;
+        }
+
+        std::sort(found.begin(), found.end(), [](const FileJob& a, const FileJob& b) { return a.Path < b.Path; });
+        for (auto& job : found)
+            jobs.push_back(std::move(job));
+    }
+
+    return true;
+}
+
+static bool ReadFile(const fs::path& path, std::string& text)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    text = stream.str();
+    return true;
+}
+
+static bool WriteFile(const fs::path& path, const std::string& text)
+{
+    std::error_code ec;
+    if (path.has_parent_path())
+        fs::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(file);
+}
+
+static void StripRootKeyword(std::string& text)
+{
+    std::string result;
+    result.reserve(text.size());
+
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        std::size_t end = text.find('\n', pos);
+        if (end == std::string::npos)
+            end = text.size();
+
+        std::size_t start = pos;
+        if (text.compare(start, 5, "Root ") == 0)
+            start += 5;
+        else if (end - start == 4 && text.compare(start, 4, "Root") == 0)
+            start += 4;
+
+        result.append(text, start, end - start);
+        if (end < text.size())
+            result += '\n';
+
+        pos = end + 1;
+    }
+
+    text.swap(result);
+}
+
+static void ProcessFile(AbilityGraph& graph, AbilityTextWriter& writer, unsigned writeJobs, const Options& options, FileJob& job)
+{
+    std::string text;
+    if (!ReadFile(job.Path, text))
+    {
+        job.IoError = true;
+        job.Diagnostics = "\nerror: cannot read file";
+        return;
+    }
+
+    // Files are unrelated, start over so ids do not depend on the previous file
+    graph.Clear();
+    graph.ParseText(text, job.Diagnostics);
+
+    // A partial graph would drop tokens, never write it back over the source.
+    if (!job.Diagnostics.empty() || graph.root_nodes.empty())
+        return;
+
+    graph.ParseNodes(job.Output, writer, writeJobs);
+    if (options.StripRoot)
+        StripRootKeyword(job.Output);
+
+    if (!options.InPlace && options.OutDir.empty())
+        return;
+
+    const fs::path target = options.InPlace ? job.Path : fs::path(options.OutDir) / job.Relative;
+    if (!WriteFile(target, job.Output))
+    {
+        job.IoError = true;
+        job.Diagnostics += "\nerror: cannot write ";
+        job.Diagnostics += target.string();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    FunctionCatalog catalog;
+    if (!ParseModInfo(catalog, options.ModInfo.c_str()))
+    {
+        std::fprintf(stderr, "error: cannot open function catalog %s\n", options.ModInfo.c_str());
+        return 2;
+    }
+
+    std::vector<FileJob> jobs;
+    if (!CollectFiles(options, jobs))
+        return 2;
+
+    unsigned threadCount = options.Jobs ? options.Jobs : std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+    unsigned workerCount = threadCount;
+    if (workerCount > jobs.size())
+        workerCount = static_cast<unsigned>(jobs.size());
+
+    // With fewer files than threads the spare ones help writing large files
+    const unsigned writeJobs = workerCount > 0 ? threadCount / workerCount : 1;
+
+    // Each worker owns its graph and pulls the next file index from a shared
+    // counter, the catalog is read only and shared by all of them.
+    std::atomic<std::size_t> nextJob{ 0 };
+    auto worker = [&]()
+        {
+            AbilityGraph graph;
+            graph.Catalog = &catalog;
+            AbilityTextWriter writer;
+
+            for (std::size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+                ProcessFile(graph, writer, writeJobs, options, jobs[i]);
+        };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (unsigned i = 1; i < workerCount; ++i)
+        workers.emplace_back(worker);
+    if (workerCount > 0)
+        worker();
+    for (auto& thread : workers)
+        thread.join();
+
+    // Report in input order so the output is stable regardless of scheduling.
+    std::size_t failed = 0;
+    bool ioError = false;
+    for (const auto& job : jobs)
+    {
+        const bool ok = job.Diagnostics.empty();
+        if (!ok)
+            ++failed;
+        ioError |= job.IoError;
+
+        if (ok && options.Quiet)
+            continue;
+
+        std::printf("%s: %s%s\n", job.Path.string().c_str(), ok ? "ok" : "FAILED", job.Diagnostics.c_str());
+    }
+
+    std::printf("%zu file(s), %zu with diagnostics\n", jobs.size(), failed);
+
+    if (ioError)
+        return 2;
+
+    return failed ? 1 : 0;
+}
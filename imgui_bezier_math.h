@@ -93,6 +93,14 @@ inline ImCubicBezierIntersectResult ImCubicBezierLineIntersect(const ImVec2& p0,
 inline ImCubicBezierIntersectResult ImCubicBezierLineIntersect(const ImCubicBezierPoints& curve, const ImLine& line);
 
 
+// Batch variants, process many curves per call. Curves are transposed to
+// structure of arrays four at a time and evaluated with SSE when
+// IMGUI_ENABLE_SSE is defined, one by one otherwise. Results match
+// the single curve functions.
+inline void ImCubicBezierBoundingRectBatch(const ImCubicBezierPoints* curves, int count, ImRect* results);
+inline void ImProjectOnCubicBezierBatch(const ImVec2& p, const ImCubicBezierPoints* curves, int count, ImProjectResult* results, const int subdivisions = 100);
+
+
 // Adaptive Cubic Bezier subdivision.
 enum ImCubicBezierSubdivideFlags
 {
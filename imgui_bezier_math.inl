@@ -286,6 +286,188 @@ inline ImRect ImCubicBezierBoundingRect(const ImCubicBezierPoints& curve)
     return ImCubicBezierBoundingRect(curve.P0, curve.P1, curve.P2, curve.P3);
 }
 
+# ifdef IMGUI_ENABLE_SSE
+// One coordinate of four curves per register.
+struct ImCubicBezierPoints4
+{
+    __m128 X0, Y0, X1, Y1, X2, Y2, X3, Y3;
+};
+
+inline ImCubicBezierPoints4 ImCubicBezierLoad4(const ImCubicBezierPoints* curves)
+{
+    static_assert(sizeof(ImCubicBezierPoints) == 8 * sizeof(float), "");
+
+    const float* data = &curves->P0.x;
+
+    auto x0 = _mm_loadu_ps(data +  0), y0 = _mm_loadu_ps(data +  8), x1 = _mm_loadu_ps(data + 16), y1 = _mm_loadu_ps(data + 24);
+    auto x2 = _mm_loadu_ps(data +  4), y2 = _mm_loadu_ps(data + 12), x3 = _mm_loadu_ps(data + 20), y3 = _mm_loadu_ps(data + 28);
+    _MM_TRANSPOSE4_PS(x0, y0, x1, y1);
+    _MM_TRANSPOSE4_PS(x2, y2, x3, y3);
+
+    return ImCubicBezierPoints4{ x0, y0, x1, y1, x2, y2, x3, y3 };
+}
+
+inline __m128 ImSelect4(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Same operations in the same order as ImCubicBezier(), results are bit exact.
+inline __m128 ImCubicBezier4(__m128 p0, __m128 p1, __m128 p2, __m128 p3, __m128 t)
+{
+    const auto three = _mm_set1_ps(3.0f);
+    const auto a     = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+    const auto b     = _mm_mul_ps(_mm_mul_ps(a, a), a);
+    const auto c     = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    const auto w1    = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, t), a), a);
+    const auto w2    = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, t), t), a);
+
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b, p0), _mm_mul_ps(w1, p1)), _mm_mul_ps(w2, p2)), _mm_mul_ps(c, p3));
+}
+
+inline void ImCubicBezierBoundingRange4(__m128 p0, __m128 p1, __m128 p2, __m128 p3, __m128& min, __m128& max)
+{
+    const auto zero = _mm_setzero_ps();
+    const auto one  = _mm_set1_ps(1.0f);
+
+    auto mul = [](float s, __m128 v) { return _mm_mul_ps(_mm_set1_ps(s), v); };
+
+    const auto a = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(mul(3, p3), mul(9, p2)), mul(9, p1)), mul(3, p0));
+    const auto b = _mm_add_ps(_mm_sub_ps(mul(6, p0), mul(12, p1)), mul(6, p2));
+    const auto c = _mm_sub_ps(mul(3, p1), mul(3, p0));
+    const auto delta_squared = _mm_sub_ps(_mm_mul_ps(b, b), mul(4, _mm_mul_ps(a, c)));
+
+    min = _mm_min_ps(p0, p3);
+    max = _mm_max_ps(p0, p3);
+
+    const auto valid = _mm_and_ps(_mm_cmpneq_ps(a, zero), _mm_cmpge_ps(delta_squared, zero));
+    if (_mm_movemask_ps(valid) == 0)
+        return;
+
+    const auto delta = _mm_sqrt_ps(_mm_max_ps(delta_squared, zero));
+    const auto a2    = mul(2, a);
+    const auto nb    = _mm_xor_ps(b, _mm_set1_ps(-0.0f));
+
+    auto accept = [&](__m128 t)
+    {
+        const auto inside = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, one)));
+        const auto p      = ImCubicBezier4(p0, p1, p2, p3, t);
+        min = ImSelect4(inside, _mm_min_ps(min, p), min);
+        max = ImSelect4(inside, _mm_max_ps(max, p), max);
+    };
+
+    accept(_mm_div_ps(_mm_add_ps(nb, delta), a2));
+    accept(_mm_div_ps(_mm_sub_ps(nb, delta), a2));
+}
+# endif
+
+inline void ImCubicBezierBoundingRectBatch(const ImCubicBezierPoints* curves, int count, ImRect* results)
+{
+    int i = 0;
+
+# ifdef IMGUI_ENABLE_SSE
+    static_assert(sizeof(ImRect) == 4 * sizeof(float), "");
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto c = ImCubicBezierLoad4(curves + i);
+
+        __m128 min_x, max_x, min_y, max_y;
+        ImCubicBezierBoundingRange4(c.X0, c.X1, c.X2, c.X3, min_x, max_x);
+        ImCubicBezierBoundingRange4(c.Y0, c.Y1, c.Y2, c.Y3, min_y, max_y);
+
+        // Back to Min.x, Min.y, Max.x, Max.y per rect
+        _MM_TRANSPOSE4_PS(min_x, min_y, max_x, max_y);
+        _mm_storeu_ps(&results[i    ].Min.x, min_x);
+        _mm_storeu_ps(&results[i + 1].Min.x, min_y);
+        _mm_storeu_ps(&results[i + 2].Min.x, max_x);
+        _mm_storeu_ps(&results[i + 3].Min.x, max_y);
+    }
+# endif
+
+    for (; i < count; ++i)
+        results[i] = ImCubicBezierBoundingRect(curves[i]);
+}
+
+inline void ImProjectOnCubicBezierBatch(const ImVec2& point, const ImCubicBezierPoints* curves, int count, ImProjectResult* results, const int subdivisions)
+{
+    int i = 0;
+
+# ifdef IMGUI_ENABLE_SSE
+    // Same search as ImProjectOnCubicBezier(), lanes that settle early are masked out
+    const float epsilon    = 1e-5f;
+    const float fixed_step = 1.0f / static_cast<float>(subdivisions - 1);
+
+    const auto px = _mm_set1_ps(point.x);
+    const auto py = _mm_set1_ps(point.y);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto c = ImCubicBezierLoad4(curves + i);
+
+        auto best_x = px;
+        auto best_y = py;
+        auto best_t = _mm_setzero_ps();
+        auto best_d = _mm_set1_ps(FLT_MAX);
+
+        auto accept = [&](__m128 t, __m128 active)
+        {
+            const auto x  = ImCubicBezier4(c.X0, c.X1, c.X2, c.X3, t);
+            const auto y  = ImCubicBezier4(c.Y0, c.Y1, c.Y2, c.Y3, t);
+            const auto sx = _mm_sub_ps(px, x);
+            const auto sy = _mm_sub_ps(py, y);
+            const auto d  = _mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy));
+            const auto m  = _mm_and_ps(active, _mm_cmplt_ps(d, best_d));
+
+            best_x = ImSelect4(m, x, best_x);
+            best_y = ImSelect4(m, y, best_y);
+            best_t = ImSelect4(m, t, best_t);
+            best_d = ImSelect4(m, d, best_d);
+        };
+
+        const auto all = _mm_cmpeq_ps(best_t, best_t);
+
+        // Step 1: Coarse check
+        for (int j = 0; j < subdivisions; ++j)
+            accept(_mm_set1_ps(j * fixed_step), all);
+
+        // Step 2: Fine check, skipped by curves closest at either end
+        const auto at_end = _mm_or_ps(_mm_cmpeq_ps(best_t, _mm_setzero_ps()),
+            _mm_cmple_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(best_t, _mm_set1_ps(1.0f))), _mm_set1_ps(epsilon)));
+
+        const auto step   = _mm_set1_ps(fixed_step * 0.1f);
+        const auto right  = _mm_add_ps(_mm_add_ps(best_t, _mm_set1_ps(fixed_step)), step);
+        auto       t      = _mm_sub_ps(best_t, _mm_set1_ps(fixed_step));
+        auto       active = _mm_andnot_ps(at_end, _mm_cmplt_ps(t, right));
+
+        while (_mm_movemask_ps(active))
+        {
+            accept(t, active);
+            t      = _mm_add_ps(t, step);
+            active = _mm_and_ps(active, _mm_cmplt_ps(t, right));
+        }
+
+        best_d = _mm_sqrt_ps(best_d);
+
+        alignas(16) float x[4], y[4], time[4], distance[4];
+        _mm_store_ps(x, best_x);
+        _mm_store_ps(y, best_y);
+        _mm_store_ps(time, best_t);
+        _mm_store_ps(distance, best_d);
+
+        for (int j = 0; j < 4; ++j)
+        {
+            results[i + j].Point    = ImVec2(x[j], y[j]);
+            results[i + j].Time     = time[j];
+            results[i + j].Distance = distance[j];
+        }
+    }
+# endif
+
+    for (; i < count; ++i)
+        results[i] = ImProjectOnCubicBezier(point, curves[i], subdivisions);
+}
+
 inline ImProjectResult ImProjectOnCubicBezier(const ImVec2& point, const ImVec2& p0, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const int subdivisions)
 {
     // http://pomax.github.io/bezierinfo/#projections
@@ -56,6 +56,13 @@ inline ImLine ImRect_ClosestLine(const ImRect& rect_a, const ImRect& rect_b);
 inline ImLine ImRect_ClosestLine(const ImRect& rect_a, const ImRect& rect_b, float radius_a, float radius_b);
 
 
+//------------------------------------------------------------------------------
+// Squared distance from point to the closest of polyline segments, several
+// segments at once when IMGUI_ENABLE_SSE is defined.
+inline float  ImPolylineDistanceSqr(const ImVec2* points, int count, const ImVec2& p);
+inline bool   ImPolylineOverlapsRect(const ImVec2* points, int count, const ImRect& rect);
+
+
 
 //------------------------------------------------------------------------------
 namespace ImEasing {
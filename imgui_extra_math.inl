@@ -189,5 +189,102 @@ inline ImLine ImRect_ClosestLine(const ImRect& rect_a, const ImRect& rect_b, flo
 }
 
 
+//------------------------------------------------------------------------------
+inline float ImPolylineDistanceSqr(const ImVec2* points, int count, const ImVec2& p)
+{
+    if (count <= 0)
+        return FLT_MAX;
+    if (count == 1)
+        return ImLengthSqr(p - points[0]);
+
+    auto best = FLT_MAX;
+    int  i    = 0;
+
+# ifdef IMGUI_ENABLE_SSE
+    // Four segments per step, they start at points[i..i+3] and end one point later
+    const auto px   = _mm_set1_ps(p.x);
+    const auto py   = _mm_set1_ps(p.y);
+    const auto zero = _mm_setzero_ps();
+    const auto one  = _mm_set1_ps(1.0f);
+    auto best4 = _mm_set1_ps(FLT_MAX);
+
+    for (; i + 4 < count; i += 4)
+    {
+        const auto a01 = _mm_loadu_ps(&points[i].x);
+        const auto a23 = _mm_loadu_ps(&points[i + 2].x);
+        const auto b01 = _mm_loadu_ps(&points[i + 1].x);
+        const auto b23 = _mm_loadu_ps(&points[i + 3].x);
+
+        const auto ax = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0));
+        const auto ay = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1));
+        const auto dx = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0)), ax);
+        const auto dy = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1)), ay);
+        const auto wx = _mm_sub_ps(px, ax);
+        const auto wy = _mm_sub_ps(py, ay);
+
+        // Degenerate segment gives 0/0, max() returns its second operand for NaN
+        const auto dd = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const auto wd = _mm_add_ps(_mm_mul_ps(wx, dx), _mm_mul_ps(wy, dy));
+        const auto t  = _mm_min_ps(_mm_max_ps(_mm_div_ps(wd, dd), zero), one);
+
+        const auto ex = _mm_sub_ps(wx, _mm_mul_ps(t, dx));
+        const auto ey = _mm_sub_ps(wy, _mm_mul_ps(t, dy));
+        best4 = _mm_min_ps(best4, _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)));
+    }
+
+    best4 = _mm_min_ps(best4, _mm_shuffle_ps(best4, best4, _MM_SHUFFLE(2, 3, 0, 1)));
+    best4 = _mm_min_ps(best4, _mm_shuffle_ps(best4, best4, _MM_SHUFFLE(1, 0, 3, 2)));
+    best  = _mm_cvtss_f32(best4);
+# endif
+
+    for (; i + 1 < count; ++i)
+        best = ImMin(best, ImLengthSqr(p - ImLineClosestPoint(points[i], points[i + 1], p)));
+
+    return best;
+}
+
+inline bool ImPolylineOverlapsRect(const ImVec2* points, int count, const ImRect& rect)
+{
+    // Liang-Barsky, clip each segment against rect edges. Single point is
+    // a segment of zero length, inverted rect clips everything away.
+    const auto segment_count = count > 1 ? count - 1 : count;
+    for (int i = 0; i < segment_count; ++i)
+    {
+        const auto a = points[i];
+        const auto d = i + 1 < count ? points[i + 1] - a : ImVec2(0.0f, 0.0f);
+
+        auto t0 = 0.0f;
+        auto t1 = 1.0f;
+        auto clip = [&t0, &t1](float p, float q)
+        {
+            if (p == 0.0f)
+                return q >= 0.0f;
+
+            const auto r = q / p;
+            if (p < 0.0f)
+            {
+                if (r > t1)
+                    return false;
+                t0 = ImMax(t0, r);
+            }
+            else
+            {
+                if (r < t0)
+                    return false;
+                t1 = ImMin(t1, r);
+            }
+
+            return true;
+        };
+
+        if (clip(-d.x, a.x - rect.Min.x) && clip(d.x, rect.Max.x - a.x)
+         && clip(-d.y, a.y - rect.Min.y) && clip(d.y, rect.Max.y - a.y))
+            return true;
+    }
+
+    return false;
+}
+
+
 //------------------------------------------------------------------------------
 # endif // __IMGUI_EXTRA_MATH_INL__
@@ -20,6 +20,16 @@
 # include <streambuf>
 # include <type_traits>
 
+# if defined(_WIN32)
+#     ifndef WIN32_LEAN_AND_MEAN
+#         define WIN32_LEAN_AND_MEAN
+#     endif
+#     ifndef NOMINMAX
+#         define NOMINMAX
+#     endif
+#     include <windows.h> // MoveFileExA
+# endif
+
 // https://stackoverflow.com/a/8597498
 # define DECLARE_HAS_NESTED(Name, Member)                                          \
                                                                                    \
@@ -122,9 +132,15 @@ static const int c_NodeContentChannel        = 4;
 
 static const float c_GroupSelectThickness       = 6.0f;  // canvas pixels
 static const float c_LinkSelectThickness        = 5.0f;  // canvas pixels
+static const float c_LinkPolylineTolerance      = 0.5f;  // canvas pixels
+static const int   c_LinkPolylineMaxSteps       = 256;
+static const float c_NodeLodScale               = 0.25f; // view scale below which nodes are drawn with square corners
+static const float c_LinkLodScale               = 0.5f;  // view scale below which links are tessellated in screen space
+static const float c_LinkLodTolerance           = 0.5f;  // screen pixels, up to twice that between zoom tiers
 static const float c_NavigationZoomMargin       = 0.1f;  // percentage of visible bounds
 static const float c_MouseZoomDuration          = 0.15f; // seconds
 static const float c_SelectionFadeOutDuration   = 0.15f; // seconds
+static const float c_SettingsSaveMaxDelayScale  = 4.0f;  // settings changing all the time are saved after that many save delays
 
 static const auto  c_MaxMoveOverEdgeSpeed       = 10.0f;
 static const auto  c_MaxMoveOverEdgeDistance    = 300.0f;
@@ -468,7 +484,7 @@ static void ImDrawList_PolyFillScanFlood(ImDrawList *draw, std::vector<ImVec2>*
 
 static void ImDrawList_AddBezierWithArrows(ImDrawList* drawList, const ImCubicBezierPoints& curve, float thickness,
     float startArrowSize, float startArrowWidth, float endArrowSize, float endArrowWidth,
-    bool fill, ImU32 color, float strokeThickness, const ImVec2* startDirHint = nullptr, const ImVec2* endDirHint = nullptr)
+    bool fill, ImU32 color, float strokeThickness, const ImVec2* startDirHint = nullptr, const ImVec2* endDirHint = nullptr, float tessTol = 0.0f)
 {
     using namespace ax;
 
@@ -479,7 +495,18 @@ static void ImDrawList_AddBezierWithArrows(ImDrawList* drawList, const ImCubicBe
 
     if (fill)
     {
-        drawList->AddBezierCubic(curve.P0, curve.P1, curve.P2, curve.P3, color, thickness);
+        if (tessTol > 0.0f)
+        {
+            auto acceptPoint = [drawList](const ImCubicBezierSubdivideSample& r)
+            {
+                drawList->PathLineTo(r.Point);
+            };
+
+            ImCubicBezierSubdivide(acceptPoint, curve, tessTol);
+            drawList->PathStroke(color, 0, thickness);
+        }
+        else
+            drawList->AddBezierCubic(curve.P0, curve.P1, curve.P2, curve.P3, color, thickness);
 
         if (startArrowSize > 0.0f)
         {
@@ -635,6 +662,8 @@ void ed::Node::UpdateDrag(const ImVec2& offset)
     auto size = m_Bounds.GetSize();
     m_Bounds.Min = ImFloor(m_DragStart + offset);
     m_Bounds.Max = m_Bounds.Min + size;
+
+    Editor->NotifyNodeBoundsChanged(this);
 }
 
 bool ed::Node::EndDrag()
@@ -648,17 +677,20 @@ void ed::Node::Draw(ImDrawList* drawList, DrawFlags flags)
     {
         drawList->ChannelsSetCurrent(m_Channel + c_NodeBackgroundChannel);
 
+        // Zoomed far out rounding cannot be seen, square corners take few vertices
+        const auto isLod = Editor->GetView().Scale < c_NodeLodScale;
+
         drawList->AddRectFilled(
             m_Bounds.Min,
             m_Bounds.Max,
-            m_Color, m_Rounding);
+            m_Color, isLod ? 0.0f : m_Rounding);
 
         if (IsGroup(this))
         {
             drawList->AddRectFilled(
                 m_GroupBounds.Min,
                 m_GroupBounds.Max,
-                m_GroupColor, m_GroupRounding);
+                m_GroupColor, isLod ? 0.0f : m_GroupRounding);
 
             if (m_GroupBorderWidth > 0.0f)
             {
@@ -667,7 +699,7 @@ void ed::Node::Draw(ImDrawList* drawList, DrawFlags flags)
                 drawList->AddRect(
                     m_GroupBounds.Min,
                     m_GroupBounds.Max,
-                    m_GroupBorderColor, m_GroupRounding, c_AllRoundCornersFlags, m_GroupBorderWidth);
+                    m_GroupBorderColor, isLod ? 0.0f : m_GroupRounding, c_AllRoundCornersFlags, m_GroupBorderWidth);
             }
         }
 
@@ -718,9 +750,10 @@ void ed::Node::DrawBorder(ImDrawList* drawList, ImU32 color, float thickness, fl
     if (thickness > 0.0f)
     {
         const ImVec2 extraOffset = ImVec2(offset, offset);
+        const auto   rounding    = Editor->GetView().Scale < c_NodeLodScale ? 0.0f : ImMax(0.0f, m_Rounding + offset);
 
         drawList->AddRect(m_Bounds.Min - extraOffset, m_Bounds.Max + extraOffset,
-            color, ImMax(0.0f, m_Rounding + offset), c_AllRoundCornersFlags, thickness);
+            color, rounding, c_AllRoundCornersFlags, thickness);
     }
 }
 
@@ -883,7 +916,7 @@ void ed::Link::Draw(ImDrawList* drawList, DrawFlags flags)
     {
         drawList->ChannelsSetCurrent(c_LinkChannel_Links);
 
-        Draw(drawList, m_Color, 0.0f);
+        DrawRetained(drawList);
     }
     else if (flags & Selected)
     {
@@ -923,7 +956,92 @@ void ed::Link::Draw(ImDrawList* drawList, ImU32 color, float extraThickness) con
           m_EndPin &&   m_EndPin->m_ArrowWidth > 0.0f ?   m_EndPin->m_ArrowWidth + extraThickness : 0.0f,
         true, color, 1.0f,
         m_StartPin && m_StartPin->m_SnapLinkToDir ? &m_StartPin->m_Dir : nullptr,
-        m_EndPin   &&   m_EndPin->m_SnapLinkToDir ?   &m_EndPin->m_Dir : nullptr);
+        m_EndPin   &&   m_EndPin->m_SnapLinkToDir ?   &m_EndPin->m_Dir : nullptr,
+        GetLodTolerance(drawList));
+}
+
+float ed::Link::GetLodTolerance(ImDrawList* drawList) const
+{
+    // Curve is tessellated in canvas space. Zoomed far out that gives many
+    // more segments than can be seen, measure tolerance in screen pixels.
+    // Scale is snapped to powers of two, so subdivision does not change
+    // with every zoom step within a tier and links do not wobble. Retained
+    // geometry is still rebuilt on zoom, fringe scale follows it.
+    const auto viewScale = Editor->GetView().Scale;
+    if (viewScale >= c_LinkLodScale)
+        return 0.0f;
+
+    const auto tierScale = ImPow(2.0f, ImFloor(ImLog(viewScale) / ImLog(2.0f)));
+
+    // ImGui compares squared distance with its tolerance
+    return ImMax(c_LinkLodTolerance / tierScale, ImSqrt(drawList->_Data->CurveTessellationTol));
+}
+
+void ed::Link::DrawRetained(ImDrawList* drawList)
+{
+    if (!m_IsLive)
+        return;
+
+    UpdateCurve();
+
+    GeometryKey key;
+    key.Thickness            = m_Thickness;
+    key.StartArrowWidth      = m_StartPin->m_ArrowWidth;
+    key.EndArrowWidth        = m_EndPin->m_ArrowWidth;
+    key.StartSnapToDir       = m_StartPin->m_SnapLinkToDir;
+    key.EndSnapToDir         = m_EndPin->m_SnapLinkToDir;
+    key.Color                = m_Color;
+    key.FringeScale          = ImFringeScaleRef(drawList);
+    key.CurveTessellationTol = drawList->_Data->CurveTessellationTol;
+    key.TexUvWhitePixel      = drawList->_Data->TexUvWhitePixel;
+    key.TextureId            = drawList->_CmdHeader.TextureId;
+    key.Flags                = drawList->Flags;
+    key.LodTolerance         = GetLodTolerance(drawList);
+
+    // Canvas applies view transform after everything is drawn, panning
+    // leaves geometry in canvas space as it was
+    if (m_HasGeometry && m_GeometryCurveKey == m_CurveKey && m_GeometryKey == key)
+    {
+        const auto vertexCount = static_cast<int>(m_Vertices.size());
+        const auto indexCount  = static_cast<int>(m_Indices.size());
+        if (indexCount == 0)
+            return;
+
+        drawList->PrimReserve(indexCount, vertexCount);
+
+        const auto baseIndex = drawList->_VtxCurrentIdx;
+        memcpy(drawList->_VtxWritePtr, m_Vertices.data(), vertexCount * sizeof(ImDrawVert));
+        for (auto index : m_Indices)
+            *drawList->_IdxWritePtr++ = static_cast<ImDrawIdx>(baseIndex + index);
+
+        drawList->_VtxWritePtr   += vertexCount;
+        drawList->_VtxCurrentIdx += vertexCount;
+        return;
+    }
+
+    const auto commandCount = drawList->CmdBuffer.Size;
+    const auto firstVertex  = drawList->VtxBuffer.Size;
+    const auto firstIndex   = drawList->IdxBuffer.Size;
+    const auto baseIndex    = drawList->_VtxCurrentIdx;
+
+    Draw(drawList, m_Color, 0.0f);
+
+    m_HasGeometry = false;
+
+    // Crossing 64k vertices starts new command with a vertex offset, such
+    // geometry is not a single block to replay
+    const auto vertexCount = drawList->VtxBuffer.Size - firstVertex;
+    if (drawList->CmdBuffer.Size != commandCount || drawList->_VtxCurrentIdx != baseIndex + vertexCount)
+        return;
+
+    m_Vertices.assign(drawList->VtxBuffer.Data + firstVertex, drawList->VtxBuffer.Data + drawList->VtxBuffer.Size);
+    m_Indices.resize(drawList->IdxBuffer.Size - firstIndex);
+    for (size_t i = 0; i < m_Indices.size(); ++i)
+        m_Indices[i] = static_cast<ImDrawIdx>(drawList->IdxBuffer.Data[firstIndex + i] - baseIndex);
+
+    m_GeometryCurveKey = m_CurveKey;
+    m_GeometryKey      = key;
+    m_HasGeometry      = true;
 }
 
 void ed::Link::UpdateEndpoints()
@@ -933,7 +1051,21 @@ void ed::Link::UpdateEndpoints()
     m_End   = line.B;
 }
 
-ImCubicBezierPoints ed::Link::GetCurve() const
+ed::Link::CurveKey ed::Link::GetCurveKey() const
+{
+    CurveKey key;
+    key.Start          = m_Start;
+    key.End            = m_End;
+    key.StartDir       = m_StartPin->m_Dir;
+    key.EndDir         = m_EndPin->m_Dir;
+    key.StartStrength  = m_StartPin->m_Strength;
+    key.EndStrength    = m_EndPin->m_Strength;
+    key.StartArrowSize = m_StartPin->m_ArrowSize;
+    key.EndArrowSize   = m_EndPin->m_ArrowSize;
+    return key;
+}
+
+ImCubicBezierPoints ed::Link::BuildCurve() const
 {
     auto easeLinkStrength = [](const ImVec2& a, const ImVec2& b, float strength)
     {
@@ -953,26 +1085,160 @@ ImCubicBezierPoints ed::Link::GetCurve() const
     const auto           cp0 = m_Start + m_StartPin->m_Dir * startStrength;
     const auto           cp1 =   m_End +   m_EndPin->m_Dir *   endStrength;
 
-    ImCubicBezierPoints result;
-    result.P0 = m_Start;
-    result.P1 = cp0;
-    result.P2 = cp1;
-    result.P3 = m_End;
+    ImCubicBezierPoints curve;
+    curve.P0 = m_Start;
+    curve.P1 = cp0;
+    curve.P2 = cp1;
+    curve.P3 = m_End;
+    return curve;
+}
+
+void ed::Link::SetCurve(const CurveKey& key, const ImCubicBezierPoints& curve, ImRect bounds) const
+{
+    m_CurveKey    = key;
+    m_Curve       = curve;
+    m_HasCurve    = true;
+    m_HasPolyline = false;
 
-    return result;
+    if (bounds.GetWidth() == 0.0f)
+    {
+        bounds.Min.x -= 0.5f;
+        bounds.Max.x += 0.5f;
+    }
+
+    if (bounds.GetHeight() == 0.0f)
+    {
+        bounds.Min.y -= 0.5f;
+        bounds.Max.y += 0.5f;
+    }
+
+    if (m_StartPin->m_ArrowSize)
+    {
+        const auto start_dir = ImNormalized(ImCubicBezierTangent(curve.P0, curve.P1, curve.P2, curve.P3, 0.0f));
+        const auto p0 = curve.P0;
+        const auto p1 = curve.P0 - start_dir * m_StartPin->m_ArrowSize;
+        const auto min = ImMin(p0, p1);
+        const auto max = ImMax(p0, p1);
+        auto arrowBounds = ImRect(min, ImMax(max, min + ImVec2(1, 1)));
+        bounds.Add(arrowBounds);
+    }
+
+    if (m_EndPin->m_ArrowSize)
+    {
+        const auto end_dir = ImNormalized(ImCubicBezierTangent(curve.P0, curve.P1, curve.P2, curve.P3, 1.0f));
+        const auto p0 = curve.P3;
+        const auto p1 = curve.P3 + end_dir * m_EndPin->m_ArrowSize;
+        const auto min = ImMin(p0, p1);
+        const auto max = ImMax(p0, p1);
+        auto arrowBounds = ImRect(min, ImMax(max, min + ImVec2(1, 1)));
+        bounds.Add(arrowBounds);
+    }
+
+    m_CurveBounds = bounds;
 }
 
-bool ed::Link::TestHit(const ImVec2& point, float extraThickness) const
+void ed::Link::UpdateCurve() const
+{
+    const auto key = GetCurveKey();
+    if (m_HasCurve && m_CurveKey == key)
+        return;
+
+    const auto curve = BuildCurve();
+
+    SetCurve(key, curve, ImCubicBezierBoundingRect(curve));
+}
+
+void ed::Link::UpdateCurves(const vector<Link*>& links)
+{
+    vector<Link*>               staleLinks;
+    vector<CurveKey>            keys;
+    vector<ImCubicBezierPoints> curves;
+
+    for (auto link : links)
+    {
+        auto key = link->GetCurveKey();
+        if (link->m_HasCurve && link->m_CurveKey == key)
+            continue;
+
+        staleLinks.push_back(link);
+        keys.push_back(key);
+        curves.push_back(link->BuildCurve());
+    }
+
+    if (staleLinks.empty())
+        return;
+
+    vector<ImRect> bounds(curves.size());
+    ImCubicBezierBoundingRectBatch(curves.data(), static_cast<int>(curves.size()), bounds.data());
+
+    for (size_t i = 0; i < staleLinks.size(); ++i)
+        staleLinks[i]->SetCurve(keys[i], curves[i], bounds[i]);
+}
+
+ImCubicBezierPoints ed::Link::GetCurve() const
+{
+    UpdateCurve();
+
+    return m_Curve;
+}
+
+const ed::vector<ImVec2>& ed::Link::GetPolyline() const
+{
+    UpdateCurve();
+
+    if (!m_HasPolyline)
+    {
+        // Uniform steps, chord of a step of length h strays from the curve
+        // by at most h^2 / 8 * max|B''| and |B''| <= 6 * max second difference.
+        // Adaptive subdivision gives no such bound, it misses the curve
+        // overshooting past its end points.
+        const auto& c = m_Curve;
+        const auto  secondDifference = ImMax(ImLength(c.P0 - c.P1 * 2.0f + c.P2), ImLength(c.P1 - c.P2 * 2.0f + c.P3));
+        const auto  stepCount = ImClamp(static_cast<int>(ImCeil(ImSqrt(0.75f * secondDifference / c_LinkPolylineTolerance))), 1, c_LinkPolylineMaxSteps);
+
+        m_PolylineError = 0.75f * secondDifference / static_cast<float>(stepCount * stepCount);
+
+        m_Polyline.resize(stepCount + 1);
+        for (int i = 0; i <= stepCount; ++i)
+            m_Polyline[i] = ImCubicBezier(c.P0, c.P1, c.P2, c.P3, static_cast<float>(i) / stepCount);
+
+        m_HasPolyline = true;
+    }
+
+    return m_Polyline;
+}
+
+int ed::Link::TestHitPolyline(const ImVec2& point, float extraThickness) const
 {
     if (!m_IsLive)
-        return false;
+        return 0;
 
     auto bounds = GetBounds();
     if (extraThickness > 0.0f)
         bounds.Expand(extraThickness);
 
     if (!bounds.Contains(point))
-        return false;
+        return 0;
+
+    // The polyline never strays further than m_PolylineError from the curve,
+    // only points near the threshold need projecting onto the curve
+    const auto& polyline    = GetPolyline();
+    const auto  maxDistance = m_Thickness + extraThickness;
+    const auto  distance    = ImSqrt(ImPolylineDistanceSqr(polyline.data(), static_cast<int>(polyline.size()), point));
+
+    if (distance > maxDistance + m_PolylineError)
+        return 0;
+    if (distance + m_PolylineError <= maxDistance)
+        return 1;
+
+    return -1;
+}
+
+bool ed::Link::TestHit(const ImVec2& point, float extraThickness) const
+{
+    const auto hit = TestHitPolyline(point, extraThickness);
+    if (hit >= 0)
+        return hit > 0;
 
     const auto bezier = GetCurve();
     const auto result = ImProjectOnCubicBezier(point, bezier.P0, bezier.P1, bezier.P2, bezier.P3, 50);
@@ -993,6 +1259,21 @@ bool ed::Link::TestHit(const ImRect& rect, bool allowIntersect) const
     if (!allowIntersect || !rect.Overlaps(bounds))
         return false;
 
+    // Curve is not within rect, so touching it means crossing an edge.
+    // Polyline decides unless it passes within m_PolylineError of an edge.
+    const auto& polyline   = GetPolyline();
+    const auto  pointCount = static_cast<int>(polyline.size());
+
+    auto outerRect = rect;
+    outerRect.Expand(m_PolylineError);
+    if (!ImPolylineOverlapsRect(polyline.data(), pointCount, outerRect))
+        return false;
+
+    auto innerRect = rect;
+    innerRect.Expand(-m_PolylineError);
+    if (ImPolylineOverlapsRect(polyline.data(), pointCount, innerRect))
+        return true;
+
     const auto bezier = GetCurve();
 
     const auto p0 = rect.GetTL();
@@ -1014,49 +1295,12 @@ bool ed::Link::TestHit(const ImRect& rect, bool allowIntersect) const
 
 ImRect ed::Link::GetBounds() const
 {
-    if (m_IsLive)
-    {
-        const auto curve = GetCurve();
-        auto bounds = ImCubicBezierBoundingRect(curve.P0, curve.P1, curve.P2, curve.P3);
-
-        if (bounds.GetWidth() == 0.0f)
-        {
-            bounds.Min.x -= 0.5f;
-            bounds.Max.x += 0.5f;
-        }
-
-        if (bounds.GetHeight() == 0.0f)
-        {
-            bounds.Min.y -= 0.5f;
-            bounds.Max.y += 0.5f;
-        }
-
-        if (m_StartPin->m_ArrowSize)
-        {
-            const auto start_dir = ImNormalized(ImCubicBezierTangent(curve.P0, curve.P1, curve.P2, curve.P3, 0.0f));
-            const auto p0 = curve.P0;
-            const auto p1 = curve.P0 - start_dir * m_StartPin->m_ArrowSize;
-            const auto min = ImMin(p0, p1);
-            const auto max = ImMax(p0, p1);
-            auto arrowBounds = ImRect(min, ImMax(max, min + ImVec2(1, 1)));
-            bounds.Add(arrowBounds);
-        }
+    if (!m_IsLive)
+        return ImRect();
 
-        if (m_EndPin->m_ArrowSize)
-        {
-            const auto end_dir = ImNormalized(ImCubicBezierTangent(curve.P0, curve.P1, curve.P2, curve.P3, 1.0f));
-            const auto p0 = curve.P3;
-            const auto p1 = curve.P3 + end_dir * m_EndPin->m_ArrowSize;
-            const auto min = ImMin(p0, p1);
-            const auto max = ImMax(p0, p1);
-            auto arrowBounds = ImRect(min, ImMax(max, min + ImVec2(1, 1)));
-            bounds.Add(arrowBounds);
-        }
+    UpdateCurve();
 
-        return bounds;
-    }
-    else
-        return ImRect();
+    return m_CurveBounds;
 }
 
 
@@ -1079,10 +1323,15 @@ ed::EditorContext::EditorContext(const ax::NodeEditor::Config* config)
     , m_Nodes()
     , m_Pins()
     , m_Links()
+    , m_IsLinkOrderDirty(false)
+    , m_DirtyLinks()
     , m_SelectionId(1)
     , m_LastActiveLink(nullptr)
+    , m_ActiveControlNode()
     , m_Canvas()
     , m_IsCanvasVisible(false)
+    , m_IsNodeOrderDirty(false)
+    , m_NodeChannelBands()
     , m_NodeBuilder(this)
     , m_HintBuilder(this)
     , m_CurrentAction(nullptr)
@@ -1106,6 +1355,9 @@ ed::EditorContext::EditorContext(const ax::NodeEditor::Config* config)
     , m_BackgroundDoubleClickButtonIndex(-1)
     , m_IsInitialized(false)
     , m_Settings()
+    , m_SettingsChangeTime(0.0)
+    , m_SettingsFirstChangeTime(-1.0)
+    , m_SettingsWriter()
     , m_DrawList(nullptr)
     , m_ExternalChannel(0)
 {
@@ -1125,6 +1377,11 @@ ed::EditorContext::~EditorContext()
 
 void ed::EditorContext::Begin(const char* id, const ImVec2& size)
 {
+    if (m_Config.EnableProfiler)
+        m_Profiler.BeginFrame();
+
+    ProfileScope profileScope(m_Profiler, ProfilePhase::Begin);
+
     m_EditorActiveId = ImGui::GetID(id);
     ImGui::PushID(id);
 
@@ -1148,12 +1405,13 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
     //ImGui::LogToClipboard();
     //Log("---- begin ----");
 
-    static auto resetAndCollect = [](auto& objects)
+    static auto resetAndCollect = [](auto& objects, auto& index)
     {
-        objects.erase(std::remove_if(objects.begin(), objects.end(), [](auto objectWrapper)
+        objects.erase(std::remove_if(objects.begin(), objects.end(), [&index](auto objectWrapper)
         {
             if (objectWrapper->m_DeleteOnNewFrame)
             {
+                index.Remove(objectWrapper.m_ID.Get());
                 delete objectWrapper.m_Object;
                 return true;
             }
@@ -1165,9 +1423,19 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
         }), objects.end());
     };
 
-    resetAndCollect(m_Nodes);
-    resetAndCollect(m_Pins);
-    resetAndCollect(m_Links);
+    for (auto node : m_Nodes)
+        if (node->m_DeleteOnNewFrame)
+            m_NodeGrid.Remove(node);
+    for (auto link : m_Links)
+        if (link->m_DeleteOnNewFrame)
+            m_LinkGrid.Remove(link);
+
+    resetAndCollect(m_Nodes, m_NodeIndex);
+    resetAndCollect(m_Pins,  m_PinIndex);
+    resetAndCollect(m_Links, m_LinkIndex);
+
+    UpdateNodeOrder();
+    UpdateLinkOrder();
 
     m_DrawList = ImGui::GetWindowDrawList();
 
@@ -1243,6 +1511,7 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
 
     // Reserve channels for background and links
     ImDrawList_ChannelsGrow(m_DrawList, c_NodeStartChannel);
+    m_NodeChannelBands.clear();
 
     if (HasSelectionChanged())
         ++m_SelectionId;
@@ -1252,6 +1521,9 @@ void ed::EditorContext::Begin(const char* id, const ImVec2& size)
 
 void ed::EditorContext::End()
 {
+    UpdateLinkOrder();
+    UpdateLinkBounds();
+
     //auto& io          = ImGui::GetIO();
     auto  control     = BuildControl(m_CurrentAction && m_CurrentAction->IsDragging()); // NavigateAction.IsMovingOverEdge()
     //auto& editorStyle = GetStyle();
@@ -1275,14 +1547,18 @@ void ed::EditorContext::End()
     //const bool isSizing    = CurrentAction && CurrentAction->AsSize()   != nullptr;
 
     // Draw nodes
+    m_Profiler.BeginPhase(ProfilePhase::DrawNodes);
     for (auto node : m_Nodes)
         if (node->m_IsLive && node->IsVisible())
             node->Draw(m_DrawList);
+    m_Profiler.EndPhase(ProfilePhase::DrawNodes);
 
     // Draw links
+    m_Profiler.BeginPhase(ProfilePhase::DrawLinks);
     for (auto link : m_Links)
         if (link->m_IsLive && link->IsVisible())
             link->Draw(m_DrawList);
+    m_Profiler.EndPhase(ProfilePhase::DrawLinks);
 
     // Highlight selected objects
     {
@@ -1331,6 +1607,8 @@ void ed::EditorContext::End()
     for (auto controller : m_AnimationControllers)
         controller->Draw(m_DrawList);
 
+    m_Profiler.BeginPhase(ProfilePhase::ProcessActions);
+
     if (m_CurrentAction && !m_CurrentAction->Process(control))
         m_CurrentAction = nullptr;
 
@@ -1385,14 +1663,34 @@ void ed::EditorContext::End()
     // Draw selection rectangle
     m_SelectAction.Draw(m_DrawList);
 
+    m_Profiler.EndPhase(ProfilePhase::ProcessActions);
+    m_Profiler.BeginPhase(ProfilePhase::SortNodes);
+
+    // m_Nodes is kept sorted by z position between frames, full sort is done
+    // only when something may have broken that order.
+    bool sortNodes  = m_IsNodeOrderDirty;
     bool sortGroups = false;
+    bool reordered  = false;
     if (control.ActiveNode)
     {
         if (!IsGroup(control.ActiveNode))
         {
-            // Bring active node to front
-            auto activeNodeIt = std::find(m_Nodes.begin(), m_Nodes.end(), control.ActiveNode);
-            std::rotate(activeNodeIt, activeNodeIt + 1, m_Nodes.end());
+            // Bring active node to front, which is the end of the run of
+            // nodes sharing its z position
+            auto activeNodeIt = std::find(m_Nodes.begin() + control.ActiveNode->m_Order, m_Nodes.end(), control.ActiveNode);
+            if (activeNodeIt == m_Nodes.end())
+                activeNodeIt = std::find(m_Nodes.begin(), m_Nodes.end(), control.ActiveNode);
+
+            auto frontIt = sortNodes ? m_Nodes.end() : std::upper_bound(activeNodeIt, m_Nodes.end(), control.ActiveNode->m_ZPosition, [](float z, const auto& node)
+            {
+                return z < node->m_ZPosition;
+            });
+
+            if (frontIt - activeNodeIt > 1)
+            {
+                std::rotate(activeNodeIt, activeNodeIt + 1, frontIt);
+                reordered = true;
+            }
         }
         else if (!isDragging && m_CurrentAction && m_CurrentAction->AsDrag())
         {
@@ -1409,36 +1707,144 @@ void ed::EditorContext::End()
         }
     }
 
+    auto groupSize = [this](Node* node) -> ImVec2
+    {
+        return node == m_SizeAction.m_SizedNode ? m_SizeAction.GetStartGroupBounds().GetSize() : node->m_GroupBounds.GetSize();
+    };
+
+    // Order sorting below would produce: by z position, then groups before
+    // regular nodes, groups by area from largest.
+    auto isNodeOrderValid = [&groupSize](const vector<ObjectWrapper<Node>>& nodes)
+    {
+        for (size_t i = 1; i < nodes.size(); ++i)
+        {
+            auto lhs = nodes[i - 1].m_Object;
+            auto rhs = nodes[i].m_Object;
+
+            if (lhs->m_ZPosition != rhs->m_ZPosition)
+            {
+                if (lhs->m_ZPosition > rhs->m_ZPosition)
+                    return false;
+                continue;
+            }
+
+            if (!IsGroup(rhs))
+                continue;
+            if (!IsGroup(lhs))
+                return false;
+
+            const auto lhsSize = groupSize(lhs);
+            const auto rhsSize = groupSize(rhs);
+            if (lhsSize.x * lhsSize.y < rhsSize.x * rhsSize.y)
+                return false;
+        }
+
+        return true;
+    };
+
     // Sort nodes if bounds of node changed
-    if (sortGroups || ((m_Settings.m_DirtyReason & (SaveReasonFlags::Position | SaveReasonFlags::Size)) != SaveReasonFlags::None))
+    if (sortGroups || ((m_Settings.m_DirtyReason & (SaveReasonFlags::Position | SaveReasonFlags::Size)) != SaveReasonFlags::None && (sortNodes || !isNodeOrderValid(m_Nodes))))
     {
         // Bring all groups before regular nodes
         auto groupsItEnd = std::stable_partition(m_Nodes.begin(), m_Nodes.end(), IsGroup);
 
         // Sort groups by area
-        std::sort(m_Nodes.begin(), groupsItEnd, [this](Node* lhs, Node* rhs)
+        std::sort(m_Nodes.begin(), groupsItEnd, [&groupSize](Node* lhs, Node* rhs)
         {
-            const auto& lhsSize = lhs == m_SizeAction.m_SizedNode ? m_SizeAction.GetStartGroupBounds().GetSize() : lhs->m_GroupBounds.GetSize();
-            const auto& rhsSize = rhs == m_SizeAction.m_SizedNode ? m_SizeAction.GetStartGroupBounds().GetSize() : rhs->m_GroupBounds.GetSize();
+            const auto lhsSize = groupSize(lhs);
+            const auto rhsSize = groupSize(rhs);
 
             const auto lhsArea = lhsSize.x * lhsSize.y;
             const auto rhsArea = rhsSize.x * rhsSize.y;
 
             return lhsArea > rhsArea;
         });
+
+        sortNodes = true;
     }
 
     // Apply Z order
-    std::stable_sort(m_Nodes.begin(), m_Nodes.end(), [](const auto& lhs, const auto& rhs)
+    if (sortNodes)
     {
-        return lhs->m_ZPosition < rhs->m_ZPosition;
-    });
+        std::stable_sort(m_Nodes.begin(), m_Nodes.end(), [](const auto& lhs, const auto& rhs)
+        {
+            return lhs->m_ZPosition < rhs->m_ZPosition;
+        });
+
+        m_IsNodeOrderDirty = false;
+        reordered = true;
+    }
+
+    if (reordered)
+        UpdateNodeOrder();
+
+    m_Profiler.EndPhase(ProfilePhase::SortNodes);
+    m_Profiler.BeginPhase(ProfilePhase::MergeChannels);
 
 # if 1
-    // Every node has few channels assigned. Grow channel list
-    // to hold twice as much of channels and place them in
-    // node drawing order.
+    if (m_Config.EnableLayeredNodeChannels)
     {
+        // Nodes share channels per band. Place bands in the order
+        // nodes are drawn: by z position, groups before regular nodes.
+        std::stable_sort(m_NodeChannelBands.begin(), m_NodeChannelBands.end(), [](const NodeChannelBand& lhs, const NodeChannelBand& rhs)
+        {
+            if (lhs.m_ZPosition != rhs.m_ZPosition)
+                return lhs.m_ZPosition < rhs.m_ZPosition;
+            return lhs.m_IsGroup && !rhs.m_IsGroup;
+        });
+
+        auto bandCount = static_cast<int>(m_NodeChannelBands.size());
+        auto nodeChannelCount = m_DrawList->_Splitter._Count;
+        ImDrawList_ChannelsGrow(m_DrawList, m_DrawList->_Splitter._Count + c_ChannelsPerNode * bandCount + c_LinkChannelCount);
+
+        int targetChannel = nodeChannelCount;
+
+        vector<int> bandChannels;
+        bandChannels.reserve(bandCount);
+
+        auto copyBand = [this, &targetChannel, &bandChannels](NodeChannelBand& band)
+        {
+            for (int i = 0; i < c_ChannelsPerNode; ++i)
+                ImDrawList_SwapChannels(m_DrawList, band.m_Channel + i, targetChannel + i);
+
+            bandChannels.push_back(band.m_Channel);
+            band.m_Channel = targetChannel;
+            targetChannel += c_ChannelsPerNode;
+        };
+
+        auto groupBandsEnd = std::find_if(m_NodeChannelBands.begin(), m_NodeChannelBands.end(), [](const NodeChannelBand& band) { return !band.m_IsGroup; });
+
+        // Copy group bands
+        std::for_each(m_NodeChannelBands.begin(), groupBandsEnd, copyBand);
+
+        // Copy links
+        for (int i = 0; i < c_LinkChannelCount; ++i, ++targetChannel)
+            ImDrawList_SwapChannels(m_DrawList, c_LinkStartChannel + i, targetChannel);
+
+        // Copy regular node bands
+        std::for_each(groupBandsEnd, m_NodeChannelBands.end(), copyBand);
+
+        // Point nodes at new location of their band, there are only few bands
+        for (auto node : m_Nodes)
+        {
+            if (!node->m_IsLive)
+                continue;
+
+            for (int i = 0; i < bandCount; ++i)
+            {
+                if (bandChannels[i] == node->m_Channel)
+                {
+                    node->m_Channel = m_NodeChannelBands[i].m_Channel;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Every node has few channels assigned. Grow channel list
+        // to hold twice as much of channels and place them in
+        // node drawing order.
         // Copy group nodes
         auto liveNodeCount = static_cast<int>(std::count_if(m_Nodes.begin(), m_Nodes.end(), [](Node* node) { return node->m_IsLive; }));
 
@@ -1474,6 +1880,8 @@ void ed::EditorContext::End()
     }
 # endif
 
+    m_Profiler.EndPhase(ProfilePhase::MergeChannels);
+
     // ImGui::PopClipRect();
 
     // Draw grid
@@ -1566,7 +1974,9 @@ void ed::EditorContext::End()
 
     UpdateAnimations();
 
+    m_Profiler.BeginPhase(ProfilePhase::MergeChannels);
     m_DrawList->ChannelsMerge();
+    m_Profiler.EndPhase(ProfilePhase::MergeChannels);
 
     // #debug
     // drawList->AddRectFilled(ImVec2(-10.0f, -10.0f), ImVec2(10.0f, 10.0f), IM_COL32(255, 0, 255, 255));
@@ -1603,11 +2013,34 @@ void ed::EditorContext::End()
     if (HasSelectionChanged())
         MakeDirty(SaveReasonFlags::Selection);
 
+    SaveReasonFlags failedReason;
+    if (m_SettingsWriter.ConsumeFailure(failedReason))
+        MakeDirty(failedReason);
+
     if (m_Settings.m_IsDirty && !m_CurrentAction)
-        SaveSettings();
+    {
+        // Coalesce changes, save once settings stay unchanged for a while
+        const auto saveDelay = m_Config.SettingsSaveDelay;
+        const auto time      = ImGui::GetTime();
+        if (saveDelay <= 0.0f || (m_SettingsFirstChangeTime >= 0.0 &&
+            (time - m_SettingsChangeTime >= saveDelay || time - m_SettingsFirstChangeTime >= saveDelay * c_SettingsSaveMaxDelayScale)))
+        {
+            SaveSettings();
+
+            // Failed save is retried once save delay passes again. Without
+            // delay it is retried with any next frame.
+            if (m_Settings.m_IsDirty && saveDelay > 0.0f)
+            {
+                m_SettingsChangeTime      = time;
+                m_SettingsFirstChangeTime = time;
+            }
+        }
+    }
 
     m_DrawList = nullptr;
     m_IsFirstFrame = false;
+
+    m_Profiler.EndFrame();
 }
 
 bool ed::EditorContext::DoLink(LinkId id, PinId startPinId, PinId endPinId, ImU32 color, float thickness)
@@ -1633,6 +2066,8 @@ bool ed::EditorContext::DoLink(LinkId id, PinId startPinId, PinId endPinId, ImU3
 
     link->UpdateEndpoints();
 
+    NotifyLinkBoundsChanged(link);
+
     return true;
 }
 
@@ -1649,6 +2084,7 @@ void ed::EditorContext::SetNodePosition(NodeId nodeId, const ImVec2& position)
     {
         node->m_Bounds.Translate(position - node->m_Bounds.Min);
         node->m_Bounds.Floor();
+        NotifyNodeBoundsChanged(node);
         MakeDirty(NodeEditor::SaveReasonFlags::Position, node);
     }
 }
@@ -1691,6 +2127,67 @@ ImVec2 ed::EditorContext::GetNodeSize(NodeId nodeId)
     return node->m_Bounds.GetSize();
 }
 
+bool ed::EditorContext::IsNodeVisible(NodeId nodeId, float margin)
+{
+    auto node = FindNode(nodeId);
+
+    // Size of a node is known only after it was built once
+    if (!node || ImRect_IsEmpty(node->m_Bounds))
+        return true;
+
+    auto bounds = node->m_Bounds;
+    bounds.Expand(margin);
+
+    return bounds.Overlaps(m_Canvas.ViewRect());
+}
+
+bool ed::EditorContext::GhostNode(NodeId nodeId)
+{
+    auto node = FindNode(nodeId);
+    if (!node || ImRect_IsEmpty(node->m_Bounds))
+        return false;
+
+    // Node and its pins keep bounds from the last time they were built.
+    // Dragging or SetNodePosition() moves only the node, bring pins and
+    // group bounds along.
+    const auto offset = node->m_Bounds.Min - node->m_BuildPosition;
+    node->m_BuildPosition = node->m_Bounds.Min;
+    if (IsGroup(node))
+        node->m_GroupBounds.Translate(offset);
+
+    node->m_IsLive = true;
+    for (auto pin = node->m_LastPin; pin; pin = pin->m_PreviousPin)
+    {
+        pin->m_Bounds.Translate(offset);
+        pin->m_Pivot.Translate(offset);
+        pin->m_IsLive = true;
+    }
+
+    // Channels are still needed, drawing and z-order expect every live node to have them
+    if (m_DrawList)
+        node->m_Channel = AcquireNodeChannels(node);
+
+    return true;
+}
+
+int ed::EditorContext::AcquireNodeChannels(Node* node)
+{
+    if (m_Config.EnableLayeredNodeChannels)
+    {
+        // Type is known only after node is built, use one from last frame
+        const auto isGroup = IsGroup(node);
+        for (auto& band : m_NodeChannelBands)
+            if (band.m_ZPosition == node->m_ZPosition && band.m_IsGroup == isGroup)
+                return band.m_Channel;
+
+        m_NodeChannelBands.push_back({ node->m_ZPosition, isGroup, m_DrawList->_Splitter._Count });
+    }
+
+    auto channel = m_DrawList->_Splitter._Count;
+    ImDrawList_ChannelsGrow(m_DrawList, channel + c_ChannelsPerNode);
+    return channel;
+}
+
 void ed::EditorContext::SetNodeZPosition(NodeId nodeId, float z)
 {
     auto node = FindNode(nodeId);
@@ -1700,7 +2197,11 @@ void ed::EditorContext::SetNodeZPosition(NodeId nodeId, float z)
         node->m_IsLive = false;
     }
 
-    node->m_ZPosition = z;
+    if (node->m_ZPosition != z)
+    {
+        node->m_ZPosition = z;
+        m_IsNodeOrderDirty = true;
+    }
 }
 
 float ed::EditorContext::GetNodeZPosition(NodeId nodeId)
@@ -1750,6 +2251,8 @@ void ed::EditorContext::UpdateNodeState(Node* node)
     node->m_GroupBounds.Min = settings->m_Location;
     node->m_GroupBounds.Max = node->m_GroupBounds.Min + settings->m_GroupSize;
     node->m_GroupBounds.Floor();
+
+    NotifyNodeBoundsChanged(node);
 }
 
 void ed::EditorContext::RemoveSettings(Object* object)
@@ -1835,11 +2338,15 @@ bool ed::EditorContext::HasSelectionChanged()
 
 ed::Node* ed::EditorContext::FindNodeAt(const ImVec2& p)
 {
-    for (auto node : m_Nodes)
-        if (node->TestHit(p))
-            return node;
+    // First hit in m_Nodes order
+    Node* result = nullptr;
+    m_NodeGrid.Query(ImRect(p, p), [&result, &p](Node* node)
+    {
+        if ((!result || node->m_Order < result->m_Order) && node->TestHit(p))
+            result = node;
+    });
 
-    return nullptr;
+    return result;
 }
 
 void ed::EditorContext::FindNodesInRect(const ImRect& r, vector<Node*>& result, bool append, bool includeIntersecting)
@@ -1850,9 +2357,15 @@ void ed::EditorContext::FindNodesInRect(const ImRect& r, vector<Node*>& result,
     if (ImRect_IsEmpty(r))
         return;
 
-    for (auto node : m_Nodes)
+    const auto first = result.size();
+
+    m_NodeGrid.Query(r, [&](Node* node)
+    {
         if (node->TestHit(r, includeIntersecting))
             result.push_back(node);
+    });
+
+    std::sort(result.begin() + first, result.end(), [](const Node* lhs, const Node* rhs) { return lhs->m_Order < rhs->m_Order; });
 }
 
 void ed::EditorContext::FindLinksInRect(const ImRect& r, vector<Link*>& result, bool append)
@@ -1863,9 +2376,69 @@ void ed::EditorContext::FindLinksInRect(const ImRect& r, vector<Link*>& result,
     if (ImRect_IsEmpty(r))
         return;
 
-    for (auto link : m_Links)
+    UpdateLinkBounds();
+
+    const auto first = result.size();
+
+    m_LinkGrid.Query(r, [&](Link* link)
+    {
         if (link->TestHit(r))
             result.push_back(link);
+    });
+
+    // m_Links is sorted by id
+    std::sort(result.begin() + first, result.end(), [](const Link* lhs, const Link* rhs) { return lhs->m_ID.AsPointer() < rhs->m_ID.AsPointer(); });
+}
+
+void ed::EditorContext::NotifyNodeBoundsChanged(Node* node)
+{
+    // Pins may stick out of the node, node is found in their cells too.
+    // They are where node was last built, see GhostNode().
+    auto bounds = node->m_Bounds;
+    const auto offset = node->m_Bounds.Min - node->m_BuildPosition;
+    for (auto pin = node->m_LastPin; pin; pin = pin->m_PreviousPin)
+    {
+        auto pinBounds = pin->m_Bounds;
+        pinBounds.Translate(offset);
+        bounds.Add(pinBounds);
+    }
+
+    m_NodeGrid.Update(node, bounds);
+}
+
+void ed::EditorContext::NotifyLinkBoundsChanged(Link* link)
+{
+    // Bounds are computed for all changed links at once, see UpdateLinkBounds()
+    m_DirtyLinks.push_back(link);
+}
+
+void ed::EditorContext::UpdateLinkBounds()
+{
+    if (m_DirtyLinks.empty())
+        return;
+
+    Link::UpdateCurves(m_DirtyLinks);
+
+    for (auto link : m_DirtyLinks)
+        m_LinkGrid.Update(link, link->GetBounds());
+
+    m_DirtyLinks.clear();
+}
+
+void ed::EditorContext::UpdateNodeOrder()
+{
+    for (int i = 0, count = static_cast<int>(m_Nodes.size()); i < count; ++i)
+        m_Nodes[i]->m_Order = i;
+}
+
+void ed::EditorContext::UpdateLinkOrder()
+{
+    // Links are drawn and reported in id order, creating them only appends
+    if (!m_IsLinkOrderDirty)
+        return;
+
+    std::sort(m_Links.begin(), m_Links.end());
+    m_IsLinkOrderDirty = false;
 }
 
 bool ed::EditorContext::HasAnyLinks(NodeId nodeId) const
@@ -1898,6 +2471,8 @@ bool ed::EditorContext::HasAnyLinks(PinId pinId) const
 
 int ed::EditorContext::BreakLinks(NodeId nodeId)
 {
+    UpdateLinkOrder();
+
     int result = 0;
     for (auto link : m_Links)
     {
@@ -1915,6 +2490,8 @@ int ed::EditorContext::BreakLinks(NodeId nodeId)
 
 int ed::EditorContext::BreakLinks(PinId pinId)
 {
+    UpdateLinkOrder();
+
     int result = 0;
     for (auto link : m_Links)
     {
@@ -1935,6 +2512,8 @@ void ed::EditorContext::FindLinksForNode(NodeId nodeId, vector<Link*>& result, b
     if (!add)
         result.clear();
 
+    UpdateLinkOrder();
+
     for (auto link : m_Links)
     {
         if (!link->m_IsLive)
@@ -2029,7 +2608,7 @@ ed::Pin* ed::EditorContext::CreatePin(PinId id, PinKind kind)
     IM_ASSERT(nullptr == FindObject(id));
     auto pin = new Pin(this, id, kind);
     m_Pins.push_back({id, pin});
-    std::sort(m_Pins.begin(), m_Pins.end());
+    m_PinIndex.Set(id.Get(), pin);
     return pin;
 }
 
@@ -2037,8 +2616,10 @@ ed::Node* ed::EditorContext::CreateNode(NodeId id)
 {
     IM_ASSERT(nullptr == FindObject(id));
     auto node = new Node(this, id);
+    node->m_Order = static_cast<int>(m_Nodes.size());
     m_Nodes.push_back({id, node});
-    //std::sort(Nodes.begin(), Nodes.end());
+    m_NodeIndex.Set(id.Get(), node);
+    m_IsNodeOrderDirty = true;
 
     auto settings = m_Settings.FindNode(id);
     if (!settings)
@@ -2058,67 +2639,27 @@ ed::Link* ed::EditorContext::CreateLink(LinkId id)
 {
     IM_ASSERT(nullptr == FindObject(id));
     auto link = new Link(this, id);
+    if (!m_Links.empty() && link->m_ID.Get() < m_Links.back().m_ID.Get())
+        m_IsLinkOrderDirty = true;
     m_Links.push_back({id, link});
-    std::sort(m_Links.begin(), m_Links.end());
+    m_LinkIndex.Set(id.Get(), link);
 
     return link;
 }
 
-template <typename C, typename Id>
-static inline auto FindItemInLinear(C& container, Id id)
-{
-# if defined(_DEBUG)
-    auto start = container.data();
-    auto end   = container.data() + container.size();
-    for (auto it = start; it < end; ++it)
-        if ((*it).m_ID == id)
-            return it->m_Object;
-# else
-    for (auto item : container)
-        if (item.m_ID == id)
-            return item.m_Object;
-# endif
-
-   return static_cast<decltype(container[0].m_Object)>(nullptr);
-}
-
-template <typename C, typename Id>
-static inline auto FindItemIn(C& container, Id id)
-{
-//# if defined(_DEBUG)
-//    auto start = container.data();
-//    auto end   = container.data() + container.size();
-//    for (auto it = start; it < end; ++it)
-//        if ((*it)->ID == id)
-//            return *it;
-//# else
-//    for (auto item : container)
-//        if (item->ID == id)
-//            return item;
-//# endif
-    auto key = typename C::value_type{ id, nullptr };
-    auto first = container.cbegin();
-    auto last  = container.cend();
-    auto it    = std::lower_bound(first, last, key);
-    if (it != last && (key.m_ID == it->m_ID))
-        return it->m_Object;
-    else
-        return static_cast<decltype(it->m_Object)>(nullptr);
-}
-
 ed::Node* ed::EditorContext::FindNode(NodeId id)
 {
-    return FindItemInLinear(m_Nodes, id);
+    return m_NodeIndex.Find(id.Get(), nullptr);
 }
 
 ed::Pin* ed::EditorContext::FindPin(PinId id)
 {
-    return FindItemIn(m_Pins, id);
+    return m_PinIndex.Find(id.Get(), nullptr);
 }
 
 ed::Link* ed::EditorContext::FindLink(LinkId id)
 {
-    return FindItemIn(m_Links, id);
+    return m_LinkIndex.Find(id.Get(), nullptr);
 }
 
 ed::Object* ed::EditorContext::FindObject(ObjectId id)
@@ -2177,6 +2718,8 @@ void ed::EditorContext::LoadSettings()
 
 void ed::EditorContext::SaveSettings()
 {
+    ProfileScope profileScope(m_Profiler, ProfilePhase::SaveSettings);
+
     m_Config.BeginSave();
 
     for (auto& node : m_Nodes)
@@ -2202,29 +2745,87 @@ void ed::EditorContext::SaveSettings()
     m_Settings.m_ViewZoom    = m_NavigateAction.m_Zoom;
     m_Settings.m_VisibleRect = m_NavigateAction.m_VisibleRect;
 
-    if (m_Config.Save(m_Settings.Serialize(), m_Settings.m_DirtyReason))
+    if (m_Config.EnableAsyncSettingsSave && !m_Config.SaveSettings && m_Config.SettingsFile)
+    {
+        // Only saved values are copied, serialization and file write happen
+        // on writer thread. Failed write marks settings dirty again, see End().
+        SettingsSnapshot snapshot;
+        m_Settings.TakeSnapshot(snapshot);
+        m_SettingsWriter.Write(m_Config.SettingsFile, std::move(snapshot));
+        m_Settings.ClearDirty();
+    }
+    else if (m_Config.Save(m_Settings.Serialize(), m_Settings.m_DirtyReason))
         m_Settings.ClearDirty();
 
     m_Config.EndSave();
+
+    if (!m_Settings.m_IsDirty || m_Config.SettingsSaveDelay <= 0.0f)
+        m_SettingsFirstChangeTime = -1.0;
 }
 
 void ed::EditorContext::MakeDirty(SaveReasonFlags reason)
 {
     m_Settings.MakeDirty(reason);
+
+    m_SettingsChangeTime = ImGui::GetTime();
+    if (m_SettingsFirstChangeTime < 0.0)
+        m_SettingsFirstChangeTime = m_SettingsChangeTime;
 }
 
 void ed::EditorContext::MakeDirty(SaveReasonFlags reason, Node* node)
 {
     m_Settings.MakeDirty(reason, node);
+
+    m_SettingsChangeTime = ImGui::GetTime();
+    if (m_SettingsFirstChangeTime < 0.0)
+        m_SettingsFirstChangeTime = m_SettingsChangeTime;
 }
 
 ed::Link* ed::EditorContext::FindLinkAt(const ImVec2& p)
 {
-    for (auto& link : m_Links)
-        if (link->TestHit(p, c_LinkSelectThickness))
-            return link;
+    auto area = ImRect(p, p);
+    area.Expand(c_LinkSelectThickness);
+
+    UpdateLinkBounds();
 
-    return nullptr;
+    auto isBefore = [](const Link* lhs, const Link* rhs)
+    {
+        return !rhs || lhs->m_ID.AsPointer() < rhs->m_ID.AsPointer();
+    };
+
+    // First hit in m_Links order, which is sorted by id
+    Link* result = nullptr;
+    vector<Link*> candidates;
+    m_LinkGrid.Query(area, [&](Link* link)
+    {
+        if (!isBefore(link, result))
+            return;
+
+        const auto hit = link->TestHitPolyline(p, c_LinkSelectThickness);
+        if (hit > 0)
+            result = link;
+        else if (hit < 0)
+            candidates.push_back(link);
+    });
+
+    // Links passing too close to tell are projected onto their curves together
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](Link* link) { return !isBefore(link, result); }), candidates.end());
+    if (candidates.empty())
+        return result;
+
+    vector<ImCubicBezierPoints> curves;
+    curves.reserve(candidates.size());
+    for (auto link : candidates)
+        curves.push_back(link->GetCurve());
+
+    vector<ImProjectResult> projections(curves.size());
+    ImProjectOnCubicBezierBatch(p, curves.data(), static_cast<int>(curves.size()), projections.data(), 50);
+
+    for (size_t i = 0; i < candidates.size(); ++i)
+        if (projections[i].Distance <= candidates[i]->m_Thickness + c_LinkSelectThickness && isBefore(candidates[i], result))
+            result = candidates[i];
+
+    return result;
 }
 
 ImU32 ed::EditorContext::GetColor(StyleColor colorIndex) const
@@ -2270,6 +2871,28 @@ void ed::EditorContext::UnregisterAnimation(Animation* animation)
         m_LiveAnimations.erase(it);
 }
 
+bool ed::EditorContext::NeedsFrame() const
+{
+    // Settings changed during an action are saved when it ends, which takes
+    // input anyway. Delayed save needs frame only when delay passes, see
+    // GetSettingsSaveTimeout().
+    return !m_LiveAnimations.empty()
+        || m_NavigateAction.IsMovingOverEdge();
+}
+
+float ed::EditorContext::GetSettingsSaveTimeout() const
+{
+    // Without delay settings are saved at the end of frame they changed
+    // in and failed save is retried with any next frame.
+    const auto saveDelay = m_Config.SettingsSaveDelay;
+    if (!m_Settings.m_IsDirty || m_CurrentAction || saveDelay <= 0.0f || m_SettingsFirstChangeTime < 0.0)
+        return -1.0f;
+
+    const auto saveTime = ImMin(m_SettingsChangeTime + saveDelay, m_SettingsFirstChangeTime + saveDelay * c_SettingsSaveMaxDelayScale);
+
+    return ImMax(static_cast<float>(saveTime - ImGui::GetTime()), 0.0f);
+}
+
 void ed::EditorContext::UpdateAnimations()
 {
     m_LastLiveAnimations = m_LiveAnimations;
@@ -2322,6 +2945,8 @@ bool ed::EditorContext::AreShortcutsEnabled()
 
 ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
 {
+    ProfileScope profileScope(m_Profiler, ProfilePhase::BuildControl);
+
     m_IsHovered = false;
     m_IsHoveredWithoutOverlapp = false;
 
@@ -2423,12 +3048,35 @@ ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
             activeObject = object;
     };
 
-    // Process live nodes and pins.
-    for (auto nodeIt = m_Nodes.rbegin(), nodeItEnd = m_Nodes.rend(); nodeIt != nodeItEnd; ++nodeIt)
+    // Only nodes under the mouse and the one owning the active item can
+    // interact, ImGui items are emitted for those alone. Order matches
+    // m_Nodes walked backwards, so the topmost one wins the hover as before.
+    m_ControlNodes.resize(0);
+    m_NodeGrid.Query(ImRect(mousePos, mousePos), [this, &mousePos](Node* node)
+    {
+        if (!node->m_IsLive)
+            return;
+
+        bool isHit = node->m_Bounds.Contains(mousePos);
+        for (auto pin = node->m_LastPin; pin && !isHit; pin = pin->m_PreviousPin)
+            isHit = pin->m_IsLive && pin->m_Bounds.Contains(mousePos);
+
+        if (isHit)
+            m_ControlNodes.push_back(node);
+    });
+
+    if (m_ActiveControlNode)
     {
-        auto node = *nodeIt;
+        auto activeNode = FindNode(m_ActiveControlNode);
+        if (activeNode && activeNode->m_IsLive && std::find(m_ControlNodes.begin(), m_ControlNodes.end(), activeNode) == m_ControlNodes.end())
+            m_ControlNodes.push_back(activeNode);
+    }
 
-        if (!node->m_IsLive) continue;
+    std::sort(m_ControlNodes.begin(), m_ControlNodes.end(), [](const Node* lhs, const Node* rhs) { return lhs->m_Order > rhs->m_Order; });
+
+    // Process live nodes and pins.
+    for (auto node : m_ControlNodes)
+    {
 
         // Check for interactions with live pins in node before
         // processing node itself. Pins does not overlap each other
@@ -2473,6 +3121,17 @@ ed::Control ed::EditorContext::BuildControl(bool allowOffscreen)
             checkInteractionsInArea(node->m_ID, node->m_Bounds, node);
     }
 
+    // Keep emitting the active item while the mouse is away from it, ImGui
+    // drops the active id of an item that was not submitted.
+    m_ActiveControlNode = 0;
+    if (activeObject)
+    {
+        if (auto node = activeObject->AsNode())
+            m_ActiveControlNode = node->m_ID;
+        else if (auto pin = activeObject->AsPin())
+            m_ActiveControlNode = pin->m_Node ? pin->m_Node->m_ID : NodeId();
+    }
+
     // Links are not regular widgets and must be done manually since
     // ImGui does not support interactive elements with custom hit maps.
     //
@@ -2650,6 +3309,32 @@ void ed::EditorContext::ShowMetrics(const Control& control)
     m_ContextMenuAction.ShowMetrics();
     m_CreateItemAction.ShowMetrics();
     m_DeleteItemsAction.ShowMetrics();
+    if (auto frameCount = m_Profiler.GetFrameCount())
+    {
+        auto& lastFrame = m_Profiler.GetFrame(0);
+
+        auto showTimes = [this, frameCount](const char* name, double lastTime, int count, double (*getTime)(const Profiler::Frame& frame, int phase), int phase)
+        {
+            double totalTime = 0.0;
+            double peakTime  = 0.0;
+            for (int i = 0; i < frameCount; ++i)
+            {
+                auto time = getTime(m_Profiler.GetFrame(i), phase);
+                totalTime += time;
+                peakTime   = ImMax(peakTime, time);
+            }
+
+            ImGui::Text("    %-16s %8.3f %8.3f %8.3f  x%d", name, lastTime * 1000.0, totalTime * 1000.0 / frameCount, peakTime * 1000.0, count);
+        };
+
+        ImGui::Text("Profiler: %d frames", frameCount);
+        ImGui::Text("    %-16s %8s %8s %8s", "(ms)", "last", "average", "max");
+        for (int i = 0; i < Profiler::c_PhaseCount; ++i)
+            showTimes(Profiler::GetPhaseName(static_cast<ProfilePhase>(i)), lastFrame.m_PhaseTime[i], lastFrame.m_PhaseCount[i],
+                [](const Profiler::Frame& frame, int phase) { return frame.m_PhaseTime[phase]; }, i);
+        showTimes("Frame", lastFrame.m_End - lastFrame.m_Start, 1,
+            [](const Profiler::Frame& frame, int) { return frame.m_End - frame.m_Start; }, 0);
+    }
     ImGui::EndGroup();
 }
 
@@ -2673,21 +3358,26 @@ void ed::NodeSettings::MakeDirty(SaveReasonFlags reason)
     m_DirtyReason = m_DirtyReason | reason;
 }
 
-ed::json::value ed::NodeSettings::Serialize()
+static ed::json::value SerializeNodeSettings(const ImVec2& location, const ImVec2& groupSize)
 {
-    json::value result;
-    result["location"]["x"] = m_Location.x;
-    result["location"]["y"] = m_Location.y;
+    ed::json::value result;
+    result["location"]["x"] = location.x;
+    result["location"]["y"] = location.y;
 
-    if (m_GroupSize.x > 0 || m_GroupSize.y > 0)
+    if (groupSize.x > 0 || groupSize.y > 0)
     {
-        result["group_size"]["x"] = m_GroupSize.x;
-        result["group_size"]["y"] = m_GroupSize.y;
+        result["group_size"]["x"] = groupSize.x;
+        result["group_size"]["y"] = groupSize.y;
     }
 
     return result;
 }
 
+ed::json::value ed::NodeSettings::Serialize()
+{
+    return SerializeNodeSettings(m_Location, m_GroupSize);
+}
+
 bool ed::NodeSettings::Parse(const std::string& string, NodeSettings& settings)
 {
     auto settingsValue = json::value::parse(string);
@@ -2740,17 +3430,18 @@ bool ed::NodeSettings::Parse(const json::value& data, NodeSettings& result)
 //------------------------------------------------------------------------------
 ed::NodeSettings* ed::Settings::AddNode(NodeId id)
 {
+    m_NodeIndex.Set(id.Get(), static_cast<int>(m_Nodes.size()));
     m_Nodes.push_back(NodeSettings(id));
     return &m_Nodes.back();
 }
 
 ed::NodeSettings* ed::Settings::FindNode(NodeId id)
 {
-    for (auto& settings : m_Nodes)
-        if (settings.m_ID == id)
-            return &settings;
+    const auto index = m_NodeIndex.Find(id.Get(), -1);
+    if (index < 0)
+        return nullptr;
 
-    return nullptr;
+    return &m_Nodes[index];
 }
 
 void ed::Settings::RemoveNode(NodeId id)
@@ -2794,7 +3485,31 @@ void ed::Settings::MakeDirty(SaveReasonFlags reason, Node* node)
     }
 }
 
+void ed::Settings::TakeSnapshot(SettingsSnapshot& snapshot) const
+{
+    snapshot.m_DirtyReason = m_DirtyReason;
+
+    snapshot.m_Nodes.resize(0);
+    for (auto& node : m_Nodes)
+    {
+        if (node.m_WasUsed)
+            snapshot.m_Nodes.push_back({ node.m_ID, node.m_Location, node.m_GroupSize });
+    }
+
+    snapshot.m_Selection   = m_Selection;
+    snapshot.m_ViewScroll  = m_ViewScroll;
+    snapshot.m_ViewZoom    = m_ViewZoom;
+    snapshot.m_VisibleRect = m_VisibleRect;
+}
+
 std::string ed::Settings::Serialize()
+{
+    SettingsSnapshot snapshot;
+    TakeSnapshot(snapshot);
+    return snapshot.Serialize();
+}
+
+std::string ed::SettingsSnapshot::Serialize() const
 {
     json::value result;
 
@@ -2813,10 +3528,7 @@ std::string ed::Settings::Serialize()
 
     auto& nodes = result["nodes"];
     for (auto& node : m_Nodes)
-    {
-        if (node.m_WasUsed)
-            nodes[serializeObjectId(node.m_ID)] = node.Serialize();
-    }
+        nodes[serializeObjectId(node.m_ID)] = SerializeNodeSettings(node.m_Location, node.m_GroupSize);
 
     auto& selection = result["selection"];
     for (auto& id : m_Selection)
@@ -2933,6 +3645,126 @@ bool ed::Settings::Parse(const std::string& string, Settings& settings)
 
 
 
+
+//------------------------------------------------------------------------------
+//
+// Settings Writer
+//
+//------------------------------------------------------------------------------
+static bool WriteFileAtomically(const std::string& path, const std::string& data)
+{
+    // Write next to target and swap, so reader never sees half written file
+    const auto tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath);
+        if (file)
+            file << data;
+
+        if (!file)
+        {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+# if defined(_WIN32)
+    const bool moved = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+# else
+    const bool moved = std::rename(tempPath.c_str(), path.c_str()) == 0;
+# endif
+
+    if (!moved)
+        std::remove(tempPath.c_str());
+
+    return moved;
+}
+
+ed::SettingsWriter::SettingsWriter()
+    : m_HasSnapshot(false)
+    , m_Quit(false)
+    , m_FailedReason(SaveReasonFlags::None)
+    , m_HasFailed(false)
+{
+}
+
+ed::SettingsWriter::~SettingsWriter()
+{
+    if (!m_Thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+
+    m_Wake.notify_one();
+    m_Thread.join();
+}
+
+void ed::SettingsWriter::Write(const char* path, SettingsSnapshot&& snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+
+        // Snapshot not written yet is replaced, carry its reasons over
+        if (m_HasSnapshot)
+            snapshot.m_DirtyReason = snapshot.m_DirtyReason | m_Snapshot.m_DirtyReason;
+
+        m_Path        = path;
+        m_Snapshot    = std::move(snapshot);
+        m_HasSnapshot = true;
+    }
+
+    if (!m_Thread.joinable())
+        m_Thread = std::thread(&SettingsWriter::Run, this);
+    else
+        m_Wake.notify_one();
+}
+
+bool ed::SettingsWriter::ConsumeFailure(SaveReasonFlags& reason)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_HasFailed)
+        return false;
+
+    reason         = m_FailedReason;
+    m_FailedReason = SaveReasonFlags::None;
+    m_HasFailed    = false;
+
+    return true;
+}
+
+void ed::SettingsWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    while (true)
+    {
+        m_Wake.wait(lock, [this] { return m_HasSnapshot || m_Quit; });
+
+        // Pending snapshot is written even when quitting
+        if (!m_HasSnapshot)
+            break;
+
+        auto snapshot = std::move(m_Snapshot);
+        auto path     = m_Path;
+        m_HasSnapshot = false;
+
+        lock.unlock();
+        const bool written = WriteFileAtomically(path, snapshot.Serialize());
+        lock.lock();
+
+        if (!written)
+        {
+            m_FailedReason = m_FailedReason | snapshot.m_DirtyReason;
+            m_HasFailed    = true;
+        }
+    }
+}
+
+
+
 //------------------------------------------------------------------------------
 //
 // Animation
@@ -3809,6 +4641,8 @@ bool ed::SizeAction::Process(const Control& control)
         m_SizedNode->m_GroupBounds.Min.y -= m_StartBounds.Min.y - m_StartGroupBounds.Min.y;
         m_SizedNode->m_GroupBounds.Max.x -= m_StartBounds.Max.x - m_StartGroupBounds.Max.x;
         m_SizedNode->m_GroupBounds.Max.y -= m_StartBounds.Max.y - m_StartGroupBounds.Max.y;
+
+        Editor->NotifyNodeBoundsChanged(m_SizedNode);
     }
     else if (!control.ActiveNode)
     {
@@ -5204,6 +6038,8 @@ void ed::NodeBuilder::Begin(NodeId nodeId)
 {
     IM_ASSERT(nullptr == m_CurrentNode);
 
+    Editor->GetProfiler().BeginPhase(ProfilePhase::BuildNodes);
+
     m_CurrentNode = Editor->GetNode(nodeId);
 
     Editor->UpdateNodeState(m_CurrentNode);
@@ -5225,6 +6061,7 @@ void ed::NodeBuilder::Begin(NodeId nodeId)
                 {
                     node->m_Bounds.Translate(ImFloor(offset));
                     node->m_GroupBounds.Translate(ImFloor(offset));
+                    Editor->NotifyNodeBoundsChanged(node);
                     Editor->MakeDirty(SaveReasonFlags::Position | SaveReasonFlags::User, node);
                 }
             }
@@ -5263,8 +6100,7 @@ void ed::NodeBuilder::Begin(NodeId nodeId)
     // Grow channel list and select user channel
     if (auto drawList = Editor->GetDrawList())
     {
-        m_CurrentNode->m_Channel = drawList->_Splitter._Count;
-        ImDrawList_ChannelsGrow(drawList, drawList->_Splitter._Count + c_ChannelsPerNode);
+        m_CurrentNode->m_Channel = Editor->AcquireNodeChannels(m_CurrentNode);
         drawList->ChannelsSetCurrent(m_CurrentNode->m_Channel + c_NodeContentChannel);
 
         m_Splitter.Clear();
@@ -5317,6 +6153,11 @@ void ed::NodeBuilder::End()
         Editor->MakeDirty(SaveReasonFlags::Size, m_CurrentNode);
     }
 
+    m_CurrentNode->m_BuildPosition = m_CurrentNode->m_Bounds.Min;
+
+    // Covers the move in Begin() too
+    Editor->NotifyNodeBoundsChanged(m_CurrentNode);
+
     if (m_IsGroup)
     {
         // Groups cannot have pins. Discard them.
@@ -5331,6 +6172,8 @@ void ed::NodeBuilder::End()
         m_CurrentNode->m_Type        = NodeType::Node;
 
     m_CurrentNode = nullptr;
+
+    Editor->GetProfiler().EndPhase(ProfilePhase::BuildNodes);
 }
 
 void ed::NodeBuilder::BeginPin(PinId pinId, PinKind kind)
@@ -5830,11 +6673,7 @@ bool ed::Config::Save(const std::string& data, SaveReasonFlags flags)
     }
     else if (SettingsFile)
     {
-        std::ofstream settingsFile(SettingsFile);
-        if (settingsFile)
-            settingsFile << data;
-
-        return !!settingsFile;
+        return WriteFileAtomically(SettingsFile, data);
     }
 
     return false;
@@ -5853,3 +6692,168 @@ void ed::Config::EndSave()
     if (EndSaveSession)
         EndSaveSession(UserPointer);
 }
+
+
+
+
+//------------------------------------------------------------------------------
+//
+// Profiler
+//
+//------------------------------------------------------------------------------
+ed::Profiler::Profiler()
+    : m_Origin(std::chrono::steady_clock::now())
+    , m_Frames()
+    , m_FrameIndex(0)
+    , m_FrameCount(0)
+    , m_IsInFrame(false)
+    , m_PhaseStart()
+{
+}
+
+void ed::Profiler::BeginFrame()
+{
+    // Ring is allocated only once something is profiled
+    if (m_Frames.empty())
+        m_Frames.resize(c_FrameCount);
+
+    auto& frame = m_Frames[m_FrameIndex];
+    frame = Frame();
+    frame.m_Start = Now();
+
+    m_IsInFrame = true;
+}
+
+void ed::Profiler::EndFrame()
+{
+    if (!m_IsInFrame)
+        return;
+
+    m_Frames[m_FrameIndex].m_End = Now();
+
+    m_FrameIndex = (m_FrameIndex + 1) % c_FrameCount;
+    m_FrameCount = ImMin(m_FrameCount + 1, c_FrameCount);
+    m_IsInFrame  = false;
+}
+
+void ed::Profiler::BeginPhase(ProfilePhase phase)
+{
+    if (!m_IsInFrame)
+        return;
+
+    m_PhaseStart[static_cast<int>(phase)] = Now();
+}
+
+void ed::Profiler::EndPhase(ProfilePhase phase)
+{
+    if (!m_IsInFrame)
+        return;
+
+    const auto index = static_cast<int>(phase);
+    const auto start = m_PhaseStart[index];
+    const auto end   = Now();
+
+    auto& frame = m_Frames[m_FrameIndex];
+    frame.m_PhaseTime[index]  += end - start;
+    frame.m_PhaseCount[index] += 1;
+
+    if (frame.m_EventCount > 0 && frame.m_Events[frame.m_EventCount - 1].m_Phase == phase)
+    {
+        auto& event = frame.m_Events[frame.m_EventCount - 1];
+        event.m_Count += 1;
+        event.m_End    = end;
+        event.m_Time  += end - start;
+    }
+    else if (frame.m_EventCount < c_EventCount)
+    {
+        // Phase totals stay exact when frame runs out of events, only trace misses them
+        auto& event = frame.m_Events[frame.m_EventCount++];
+        event.m_Phase = phase;
+        event.m_Count = 1;
+        event.m_Start = start;
+        event.m_End   = end;
+        event.m_Time  = end - start;
+    }
+}
+
+const ed::Profiler::Frame& ed::Profiler::GetFrame(int index) const
+{
+    IM_ASSERT(index >= 0 && index < m_FrameCount);
+
+    return m_Frames[(m_FrameIndex - 1 - index + 2 * c_FrameCount) % c_FrameCount];
+}
+
+bool ed::Profiler::SaveTrace(const char* path) const
+{
+    if (m_FrameCount == 0)
+        return false;
+
+    auto microseconds = [](double seconds)
+    {
+        return static_cast<json::number>(seconds * 1000000.0);
+    };
+
+    json::value events{json::type_t::array};
+
+    for (int i = m_FrameCount - 1; i >= 0; --i)
+    {
+        auto& frame = GetFrame(i);
+
+        json::value frameEvent;
+        frameEvent["name"] = "Frame";
+        frameEvent["ph"]   = "X";
+        frameEvent["ts"]   = microseconds(frame.m_Start);
+        frameEvent["dur"]  = microseconds(frame.m_End - frame.m_Start);
+        frameEvent["pid"]  = 1.0;
+        frameEvent["tid"]  = 1.0;
+        events.push_back(std::move(frameEvent));
+
+        for (int j = 0; j < frame.m_EventCount; ++j)
+        {
+            auto& event = frame.m_Events[j];
+
+            json::value phaseEvent;
+            phaseEvent["name"] = GetPhaseName(event.m_Phase);
+            phaseEvent["ph"]   = "X";
+            phaseEvent["ts"]   = microseconds(event.m_Start);
+            phaseEvent["dur"]  = microseconds(event.m_End - event.m_Start);
+            phaseEvent["pid"]  = 1.0;
+            phaseEvent["tid"]  = 1.0;
+            phaseEvent["args"]["count"]   = static_cast<json::number>(event.m_Count);
+            phaseEvent["args"]["time_us"] = microseconds(event.m_Time);
+            events.push_back(std::move(phaseEvent));
+        }
+    }
+
+    json::value trace;
+    trace["traceEvents"]     = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+
+    std::ofstream traceFile(path);
+    if (traceFile)
+        traceFile << trace.dump();
+
+    return !!traceFile;
+}
+
+const char* ed::Profiler::GetPhaseName(ProfilePhase phase)
+{
+    switch (phase)
+    {
+        case ProfilePhase::Begin:           return "Begin";
+        case ProfilePhase::BuildNodes:      return "Build Nodes";
+        case ProfilePhase::BuildControl:    return "Build Control";
+        case ProfilePhase::DrawNodes:       return "Draw Nodes";
+        case ProfilePhase::DrawLinks:       return "Draw Links";
+        case ProfilePhase::ProcessActions:  return "Process Actions";
+        case ProfilePhase::SortNodes:       return "Sort Nodes";
+        case ProfilePhase::MergeChannels:   return "Merge Channels";
+        case ProfilePhase::SaveSettings:    return "Save Settings";
+        default:                            return "<unknown>";
+    }
+}
+
+double ed::Profiler::Now() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Origin).count();
+}
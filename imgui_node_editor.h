@@ -107,6 +107,10 @@ struct Config
     int                     ContextMenuButtonIndex; // Mouse button index context menu action will react to (0-left, 1-right, 2-middle)
     bool                    EnableSmoothZoom;
     float                   SmoothZoomPower;
+    bool                    EnableLayeredNodeChannels; // Nodes with the same z position share one set of draw channels, so merge cost no longer grows with node count. Overlapping nodes in such band are not occluded by each other.
+    bool                    EnableProfiler;            // Time editor phases of every frame. Breakdown is shown in metrics, SaveProfilerTrace() writes it as Chrome trace.
+    float                   SettingsSaveDelay;         // Seconds settings have to stay unchanged before they are saved, changes in between are saved together. 0 saves at the end of every frame with changes.
+    bool                    EnableAsyncSettingsSave;   // Serialize and write SettingsFile on background thread. Not used with SaveSettings callback, callbacks are always invoked from the frame.
 
     Config()
         : SettingsFile("NodeEditor.json")
@@ -129,6 +133,10 @@ struct Config
 # else
         , SmoothZoomPower(1.3f)
 # endif
+        , EnableLayeredNodeChannels(false)
+        , EnableProfiler(false)
+        , SettingsSaveDelay(0.0f)
+        , EnableAsyncSettingsSave(false)
     {
     }
 };
@@ -353,6 +361,8 @@ IMGUI_NODE_EDITOR_API void SetNodePosition(NodeId nodeId, const ImVec2& editorPo
 IMGUI_NODE_EDITOR_API void SetGroupSize(NodeId nodeId, const ImVec2& size);
 IMGUI_NODE_EDITOR_API ImVec2 GetNodePosition(NodeId nodeId);
 IMGUI_NODE_EDITOR_API ImVec2 GetNodeSize(NodeId nodeId);
+IMGUI_NODE_EDITOR_API bool IsNodeVisible(NodeId nodeId, float margin = 0.0f); // Returns true if node bounds, grown by margin in canvas units, overlap the view. Nodes never built yet are always visible
+IMGUI_NODE_EDITOR_API bool GhostNode(NodeId nodeId); // Use instead of BeginNode/EndNode for a node that need not be built this frame. It keeps its last size and pins for links, hit-testing and selection, pins follow the node when it is dragged or positioned. Returns false if node was never built
 IMGUI_NODE_EDITOR_API void CenterNodeOnScreen(NodeId nodeId);
 IMGUI_NODE_EDITOR_API void SetNodeZPosition(NodeId nodeId, float z); // Sets node z position, nodes with higher value are drawn over nodes with lower value
 IMGUI_NODE_EDITOR_API float GetNodeZPosition(NodeId nodeId); // Returns node z position, defaults is 0.0f
@@ -409,6 +419,11 @@ IMGUI_NODE_EDITOR_API void EndShortcut();
 
 IMGUI_NODE_EDITOR_API float GetCurrentZoom();
 
+IMGUI_NODE_EDITOR_API bool NeedsFrame(); // Returns true while animations or scrolling over edge need editor to be drawn again without any input. For applications that only draw on input.
+IMGUI_NODE_EDITOR_API float GetSettingsSaveTimeout(); // Returns seconds until delayed settings save is due, negative if there is none. Editor has to be drawn then to save them, see Config::SettingsSaveDelay.
+
+IMGUI_NODE_EDITOR_API bool SaveProfilerTrace(const char* path); // Writes last profiled frames as Chrome trace event JSON, requires Config::EnableProfiler. Returns false if no frame was profiled
+
 IMGUI_NODE_EDITOR_API NodeId GetHoveredNode();
 IMGUI_NODE_EDITOR_API PinId GetHoveredPin();
 IMGUI_NODE_EDITOR_API LinkId GetHoveredLink();
@@ -407,6 +407,16 @@ ImVec2 ax::NodeEditor::GetNodeSize(NodeId nodeId)
     return s_Editor->GetNodeSize(nodeId);
 }
 
+bool ax::NodeEditor::IsNodeVisible(NodeId nodeId, float margin)
+{
+    return s_Editor->IsNodeVisible(nodeId, margin);
+}
+
+bool ax::NodeEditor::GhostNode(NodeId nodeId)
+{
+    return s_Editor->GhostNode(nodeId);
+}
+
 void ax::NodeEditor::CenterNodeOnScreen(NodeId nodeId)
 {
     if (auto node = s_Editor->FindNode(nodeId))
@@ -667,6 +677,21 @@ float ax::NodeEditor::GetCurrentZoom()
     return s_Editor->GetView().InvScale;
 }
 
+bool ax::NodeEditor::NeedsFrame()
+{
+    return s_Editor->NeedsFrame();
+}
+
+float ax::NodeEditor::GetSettingsSaveTimeout()
+{
+    return s_Editor->GetSettingsSaveTimeout();
+}
+
+bool ax::NodeEditor::SaveProfilerTrace(const char* path)
+{
+    return s_Editor->GetProfiler().SaveTrace(path);
+}
+
 ax::NodeEditor::NodeId ax::NodeEditor::GetHoveredNode()
 {
     return s_Editor->GetHoveredNode();
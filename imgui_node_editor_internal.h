@@ -32,6 +32,15 @@
 
 # include <vector>
 # include <string>
+# include <unordered_map>
+# include <algorithm>
+# include <climits>
+# include <cmath>
+# include <chrono>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <cstdint>
 
 
 //------------------------------------------------------------------------------
@@ -377,6 +386,305 @@ inline NodeRegion operator |(NodeRegion lhs, NodeRegion rhs) { return static_cas
 inline NodeRegion operator &(NodeRegion lhs, NodeRegion rhs) { return static_cast<NodeRegion>(static_cast<uint8_t>(lhs) & static_cast<uint8_t>(rhs)); }
 
 
+//------------------------------------------------------------------------------
+// Uniform grid over canvas space answering "what is in this rect" without
+// testing every object. Objects are registered in every cell their bounds
+// touch and re-registered only when they move to other cells. Objects that
+// would span too many cells (long links) are kept in one list every query
+// scans instead.
+struct SpatialGridEntry
+{
+    int      MinX      = 0;
+    int      MinY      = 0;
+    int      MaxX      = -1;
+    int      MaxY      = -1;
+    bool     IsIndexed = false;
+    bool     IsLarge   = false;
+    uint32_t Stamp     = 0;     // last query that visited the object
+};
+
+template <typename T>
+struct SpatialGrid
+{
+    static constexpr float c_CellSize         = 256.0f;   // canvas pixels
+    static constexpr int   c_MaxCellsPerObject = 64;
+
+    // Register `object` under `bounds`, moving it if it was registered before.
+    void Update(T* object, const ImRect& bounds)
+    {
+        auto& entry = object->m_GridEntry;
+
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+        const bool isLarge = !ToCells(bounds, minX, minY, maxX, maxY);
+
+        if (entry.IsIndexed && entry.IsLarge == isLarge
+            && (isLarge || (entry.MinX == minX && entry.MinY == minY && entry.MaxX == maxX && entry.MaxY == maxY)))
+            return;
+
+        Remove(object);
+
+        entry.IsIndexed = true;
+        entry.IsLarge   = isLarge;
+
+        if (isLarge)
+        {
+            m_Large.push_back(object);
+            return;
+        }
+
+        entry.MinX = minX;
+        entry.MinY = minY;
+        entry.MaxX = maxX;
+        entry.MaxY = maxY;
+
+        for (int y = minY; y <= maxY; ++y)
+            for (int x = minX; x <= maxX; ++x)
+                m_Cells[Key(x, y)].push_back(object);
+    }
+
+    void Remove(T* object)
+    {
+        auto& entry = object->m_GridEntry;
+        if (!entry.IsIndexed)
+            return;
+
+        entry.IsIndexed = false;
+
+        if (entry.IsLarge)
+        {
+            Erase(m_Large, object);
+            return;
+        }
+
+        for (int y = entry.MinY; y <= entry.MaxY; ++y)
+        {
+            for (int x = entry.MinX; x <= entry.MaxX; ++x)
+            {
+                auto it = m_Cells.find(Key(x, y));
+                if (it == m_Cells.end())
+                    continue;
+
+                Erase(it->second, object);
+                if (it->second.empty())
+                    m_Cells.erase(it);
+            }
+        }
+    }
+
+    // Call `visit` once for every object registered in a cell `rect` touches.
+    // Candidates still have to be hit tested.
+    template <typename F>
+    void Query(const ImRect& rect, F&& visit)
+    {
+        const auto stamp = ++m_Stamp;
+
+        auto visitOnce = [&](T* object)
+        {
+            if (object->m_GridEntry.Stamp == stamp)
+                return;
+
+            object->m_GridEntry.Stamp = stamp;
+            visit(object);
+        };
+
+        for (auto object : m_Large)
+            visitOnce(object);
+
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+        const bool isSmall = ToCells(rect, minX, minY, maxX, maxY, INT_MAX);
+
+        // Big rects touch more cells than there are occupied ones, walk those instead
+        const auto cellCount = isSmall ? static_cast<double>(maxX - minX + 1) * (maxY - minY + 1) : HUGE_VAL;
+        if (cellCount > static_cast<double>(m_Cells.size()))
+        {
+            for (auto& cell : m_Cells)
+            {
+                const auto x = static_cast<int>(static_cast<int32_t>(cell.first >> 32));
+                const auto y = static_cast<int>(static_cast<int32_t>(cell.first & 0xFFFFFFFFu));
+                if (isSmall && (x < minX || x > maxX || y < minY || y > maxY))
+                    continue;
+
+                for (auto object : cell.second)
+                    visitOnce(object);
+            }
+            return;
+        }
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                auto it = m_Cells.find(Key(x, y));
+                if (it == m_Cells.end())
+                    continue;
+
+                for (auto object : it->second)
+                    visitOnce(object);
+            }
+        }
+    }
+
+private:
+    static uint64_t Key(int x, int y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+
+    // False if `rect` spans more than `maxCells` cells (or is not finite).
+    static bool ToCells(const ImRect& rect, int& minX, int& minY, int& maxX, int& maxY, int maxCells = c_MaxCellsPerObject)
+    {
+        const float x0 = ImFloor(rect.Min.x / c_CellSize);
+        const float y0 = ImFloor(rect.Min.y / c_CellSize);
+        const float x1 = ImFloor(ImMax(rect.Min.x, rect.Max.x) / c_CellSize);
+        const float y1 = ImFloor(ImMax(rect.Min.y, rect.Max.y) / c_CellSize);
+
+        const float cells = (x1 - x0 + 1.0f) * (y1 - y0 + 1.0f);
+        if (!(cells <= static_cast<float>(maxCells)) || !(ImFabs(x0) < 1e9f && ImFabs(y0) < 1e9f && ImFabs(x1) < 1e9f && ImFabs(y1) < 1e9f))
+            return false;
+
+        minX = static_cast<int>(x0);
+        minY = static_cast<int>(y0);
+        maxX = static_cast<int>(x1);
+        maxY = static_cast<int>(y1);
+        return true;
+    }
+
+    static void Erase(vector<T*>& list, T* object)
+    {
+        auto it = std::find(list.begin(), list.end(), object);
+        if (it == list.end())
+            return;
+
+        *it = list.back();
+        list.pop_back();
+    }
+
+    std::unordered_map<uint64_t, vector<T*>> m_Cells;
+    vector<T*>                               m_Large;
+    uint32_t                                 m_Stamp = 0;
+};
+
+
+//------------------------------------------------------------------------------
+// Open addressing hash map from an id to a value. Linear probing, removal
+// shifts following entries back so no tombstones pile up.
+template <typename V>
+struct IdMap
+{
+    V Find(uintptr_t key, V notFound = V()) const
+    {
+        if (m_Count == 0)
+            return notFound;
+
+        for (size_t i = Slot(key); ; i = (i + 1) & m_Mask)
+        {
+            const auto& entry = m_Entries[i];
+            if (!entry.IsUsed)
+                return notFound;
+            if (entry.Key == key)
+                return entry.Value;
+        }
+    }
+
+    void Set(uintptr_t key, V value)
+    {
+        // Keep load under 3/4
+        if ((m_Count + 1) * 4 > m_Entries.size() * 3)
+            Grow();
+
+        for (size_t i = Slot(key); ; i = (i + 1) & m_Mask)
+        {
+            auto& entry = m_Entries[i];
+            if (!entry.IsUsed)
+            {
+                entry.Key    = key;
+                entry.Value  = value;
+                entry.IsUsed = true;
+                ++m_Count;
+                return;
+            }
+
+            if (entry.Key == key)
+            {
+                entry.Value = value;
+                return;
+            }
+        }
+    }
+
+    void Remove(uintptr_t key)
+    {
+        if (m_Count == 0)
+            return;
+
+        size_t hole = Slot(key);
+        for (; ; hole = (hole + 1) & m_Mask)
+        {
+            if (!m_Entries[hole].IsUsed)
+                return;
+            if (m_Entries[hole].Key == key)
+                break;
+        }
+
+        // Move back every entry whose probe sequence crosses the hole
+        for (size_t i = (hole + 1) & m_Mask; m_Entries[i].IsUsed; i = (i + 1) & m_Mask)
+        {
+            const auto home = Slot(m_Entries[i].Key);
+            if (((i - home) & m_Mask) >= ((i - hole) & m_Mask))
+            {
+                m_Entries[hole] = m_Entries[i];
+                hole = i;
+            }
+        }
+
+        m_Entries[hole].IsUsed = false;
+        --m_Count;
+    }
+
+    void Clear()
+    {
+        m_Entries.clear();
+        m_Mask  = 0;
+        m_Count = 0;
+    }
+
+    size_t Size() const { return m_Count; }
+
+private:
+    struct Entry
+    {
+        uintptr_t Key    = 0;
+        V         Value  = V();
+        bool      IsUsed = false;
+    };
+
+    size_t Slot(uintptr_t key) const
+    {
+        // Ids are often small sequential numbers, mix bits before masking
+        uint64_t hash = key;
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash) & m_Mask;
+    }
+
+    void Grow()
+    {
+        vector<Entry> entries(m_Entries.empty() ? 16 : m_Entries.size() * 2);
+        entries.swap(m_Entries);
+        m_Mask  = m_Entries.size() - 1;
+        m_Count = 0;
+
+        for (auto& entry : entries)
+            if (entry.IsUsed)
+                Set(entry.Key, entry.Value);
+    }
+
+    vector<Entry> m_Entries;
+    size_t        m_Mask  = 0;
+    size_t        m_Count = 0;
+};
+
 struct Node final: Object
 {
     using IdType = NodeId;
@@ -388,6 +696,7 @@ struct Node final: Object
     int      m_Channel;
     Pin*     m_LastPin;
     ImVec2   m_DragStart;
+    ImVec2   m_BuildPosition;   // m_Bounds.Min pins and group bounds were laid out at, see GhostNode()
 
     ImU32    m_Color;
     ImU32    m_BorderColor;
@@ -405,6 +714,9 @@ struct Node final: Object
     bool     m_RestoreState;
     bool     m_CenterOnScreen;
 
+    int              m_Order;       // position in EditorContext::m_Nodes
+    SpatialGridEntry m_GridEntry;
+
     Node(EditorContext* editor, NodeId id)
         : Object(editor)
         , m_ID(id)
@@ -414,6 +726,7 @@ struct Node final: Object
         , m_Channel(0)
         , m_LastPin(nullptr)
         , m_DragStart()
+        , m_BuildPosition()
         , m_Color(IM_COL32_WHITE)
         , m_BorderColor(IM_COL32_BLACK)
         , m_BorderWidth(0)
@@ -422,6 +735,7 @@ struct Node final: Object
         , m_HighlightConnectedLinks(false)
         , m_RestoreState(false)
         , m_CenterOnScreen(false)
+        , m_Order(0)
     {
     }
 
@@ -462,6 +776,71 @@ struct Link final: Object
     ImVec2 m_Start;
     ImVec2 m_End;
 
+    SpatialGridEntry m_GridEntry;
+
+    // Everything the curve depends on, cached results stay valid while it
+    // does not change.
+    struct CurveKey
+    {
+        ImVec2 Start;
+        ImVec2 End;
+        ImVec2 StartDir;
+        ImVec2 EndDir;
+        float  StartStrength;
+        float  EndStrength;
+        float  StartArrowSize;
+        float  EndArrowSize;
+
+        bool operator==(const CurveKey& rhs) const
+        {
+            return Start == rhs.Start && End == rhs.End && StartDir == rhs.StartDir && EndDir == rhs.EndDir
+                && StartStrength == rhs.StartStrength && EndStrength == rhs.EndStrength
+                && StartArrowSize == rhs.StartArrowSize && EndArrowSize == rhs.EndArrowSize;
+        }
+    };
+
+    // Everything the tessellated link depends on besides the curve.
+    struct GeometryKey
+    {
+        float       Thickness;
+        float       StartArrowWidth;
+        float       EndArrowWidth;
+        bool        StartSnapToDir;
+        bool        EndSnapToDir;
+        ImU32       Color;
+        float       FringeScale;            // follows zoom
+        float       CurveTessellationTol;
+        ImVec2      TexUvWhitePixel;
+        ImTextureID TextureId;
+        int         Flags;
+        float       LodTolerance;           // see GetLodTolerance()
+
+        bool operator==(const GeometryKey& rhs) const
+        {
+            return Thickness == rhs.Thickness && StartArrowWidth == rhs.StartArrowWidth && EndArrowWidth == rhs.EndArrowWidth
+                && StartSnapToDir == rhs.StartSnapToDir && EndSnapToDir == rhs.EndSnapToDir && Color == rhs.Color
+                && FringeScale == rhs.FringeScale && CurveTessellationTol == rhs.CurveTessellationTol
+                && TexUvWhitePixel == rhs.TexUvWhitePixel && TextureId == rhs.TextureId && Flags == rhs.Flags
+                && LodTolerance == rhs.LodTolerance;
+        }
+    };
+
+    mutable CurveKey            m_CurveKey;
+    mutable ImCubicBezierPoints m_Curve;
+    mutable ImRect              m_CurveBounds;
+    mutable vector<ImVec2>      m_Polyline;
+    mutable float               m_PolylineError;
+    mutable bool                m_HasCurve;
+    mutable bool                m_HasPolyline;
+
+    // Vertices and indices (relative to the first vertex) in canvas space
+    // from the last time the link was drawn
+    CurveKey                    m_GeometryCurveKey;
+    GeometryKey                 m_GeometryKey;
+    vector<ImDrawVert>          m_Vertices;
+    vector<ImDrawIdx>           m_Indices;
+    bool                        m_HasGeometry;
+
     Link(EditorContext* editor, LinkId id)
         : Object(editor)
         , m_ID(id)
@@ -469,6 +848,15 @@ struct Link final: Object
         , m_EndPin(nullptr)
         , m_Color(IM_COL32_WHITE)
         , m_Thickness(1.0f)
+        , m_CurveKey()
+        , m_Curve()
+        , m_CurveBounds()
+        , m_PolylineError(0.0f)
+        , m_HasCurve(false)
+        , m_HasPolyline(false)
+        , m_GeometryCurveKey()
+        , m_GeometryKey()
+        , m_HasGeometry(false)
     {
     }
 
@@ -483,12 +871,31 @@ struct Link final: Object
 
     ImCubicBezierPoints GetCurve() const;
 
+    // Curve flattened to a polyline, no further than m_PolylineError from it.
+    const vector<ImVec2>& GetPolyline() const;
+
+    // Refreshes curves of links whose inputs changed, bounds of all of them
+    // are computed in one batch.
+    static void UpdateCurves(const vector<Link*>& links);
+
+    // Hit test against the polyline alone: 1 hit, 0 miss, -1 when point is
+    // too close to the threshold to tell without projecting onto the curve.
+    int TestHitPolyline(const ImVec2& point, float extraThickness = 0.0f) const;
+
     virtual bool TestHit(const ImVec2& point, float extraThickness = 0.0f) const override final;
     virtual bool TestHit(const ImRect& rect, bool allowIntersect = true) const override final;
 
     virtual ImRect GetBounds() const override final;
 
     virtual Link* AsLink() override final { return this; }
+
+private:
+    CurveKey GetCurveKey() const;
+    ImCubicBezierPoints BuildCurve() const;
+    void SetCurve(const CurveKey& key, const ImCubicBezierPoints& curve, ImRect bounds) const;
+    void UpdateCurve() const;
+    float GetLodTolerance(ImDrawList* drawList) const;
+    void DrawRetained(ImDrawList* drawList);
 };
 
 struct NodeSettings
@@ -524,12 +931,15 @@ struct NodeSettings
     static bool Parse(const json::value& data, NodeSettings& result);
 };
 
+struct SettingsSnapshot;
+
 struct Settings
 {
     bool                 m_IsDirty;
     SaveReasonFlags      m_DirtyReason;
 
     vector<NodeSettings> m_Nodes;
+    IdMap<int>           m_NodeIndex;   // id to index in m_Nodes
     vector<ObjectId>     m_Selection;
     ImVec2               m_ViewScroll;
     float                m_ViewZoom;
@@ -551,11 +961,68 @@ struct Settings
     void ClearDirty(Node* node = nullptr);
     void MakeDirty(SaveReasonFlags reason, Node* node = nullptr);
 
+    void TakeSnapshot(SettingsSnapshot& snapshot) const;
+
     std::string Serialize();
 
     static bool Parse(const std::string& string, Settings& settings);
 };
 
+// Only what is written to settings file, without lookup tables and dirty
+// state of every node.
+struct SettingsSnapshot
+{
+    struct NodeEntry
+    {
+        NodeId m_ID;
+        ImVec2 m_Location;
+        ImVec2 m_GroupSize;
+    };
+
+    SaveReasonFlags   m_DirtyReason;
+    vector<NodeEntry> m_Nodes;       // used nodes only
+    vector<ObjectId>  m_Selection;
+    ImVec2            m_ViewScroll;
+    float             m_ViewZoom;
+    ImRect            m_VisibleRect;
+
+    SettingsSnapshot()
+        : m_DirtyReason(SaveReasonFlags::None)
+        , m_ViewScroll(0, 0)
+        , m_ViewZoom(1.0f)
+        , m_VisibleRect()
+    {
+    }
+
+    std::string Serialize() const;
+};
+
+// Serializes settings and writes them to file on background thread. Only
+// newest snapshot is kept, one still waiting for the thread is replaced.
+// Destructor returns after pending snapshot is written.
+struct SettingsWriter
+{
+    SettingsWriter();
+    ~SettingsWriter();
+
+    void Write(const char* path, SettingsSnapshot&& snapshot);
+
+    bool ConsumeFailure(SaveReasonFlags& reason); // true if write failed since last call
+
+private:
+    void Run();
+
+    std::thread             m_Thread;
+    std::mutex              m_Mutex;
+    std::condition_variable m_Wake;
+    std::string             m_Path;
+    SettingsSnapshot        m_Snapshot;
+    bool                    m_HasSnapshot;
+    bool                    m_Quit;
+    SaveReasonFlags         m_FailedReason;
+    bool                    m_HasFailed;
+};
+
 struct Control
 {
     Object* HotObject;
@@ -1288,6 +1755,85 @@ enum class SuspendFlags : uint8_t
 inline SuspendFlags operator |(SuspendFlags lhs, SuspendFlags rhs) { return static_cast<SuspendFlags>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs)); }
 inline SuspendFlags operator &(SuspendFlags lhs, SuspendFlags rhs) { return static_cast<SuspendFlags>(static_cast<uint8_t>(lhs) & static_cast<uint8_t>(rhs)); }
 
+enum class ProfilePhase : uint8_t
+{
+    Begin,
+    BuildNodes,
+    BuildControl,
+    DrawNodes,
+    DrawLinks,
+    ProcessActions,
+    SortNodes,
+    MergeChannels,
+    SaveSettings,
+
+    Count
+};
+
+// Wall time spent in editor phases over last frames, see Config::EnableProfiler.
+// Consecutive spans of one phase are folded into single event, so phases
+// entered per node do not flood frame with events.
+struct Profiler
+{
+    static const int c_PhaseCount  = static_cast<int>(ProfilePhase::Count);
+    static const int c_FrameCount  = 120;
+    static const int c_EventCount  = 32;
+
+    struct Event
+    {
+        ProfilePhase    m_Phase;
+        int             m_Count;    // spans folded into this event
+        double          m_Start;    // seconds since profiler was created
+        double          m_End;
+        double          m_Time;     // sum of folded spans, without gaps between them
+    };
+
+    struct Frame
+    {
+        double  m_Start;
+        double  m_End;
+        double  m_PhaseTime[c_PhaseCount];
+        int     m_PhaseCount[c_PhaseCount];
+        Event   m_Events[c_EventCount];
+        int     m_EventCount;
+    };
+
+    Profiler();
+
+    void BeginFrame();
+    void EndFrame();
+
+    void BeginPhase(ProfilePhase phase);
+    void EndPhase(ProfilePhase phase);
+
+    int          GetFrameCount() const { return m_FrameCount; }
+    const Frame& GetFrame(int index) const; // 0 is the most recent completed frame
+
+    bool SaveTrace(const char* path) const; // Chrome trace event format
+
+    static const char* GetPhaseName(ProfilePhase phase);
+
+private:
+    double Now() const;
+
+    std::chrono::steady_clock::time_point m_Origin;
+    vector<Frame>   m_Frames;
+    int             m_FrameIndex;   // frame being recorded
+    int             m_FrameCount;
+    bool            m_IsInFrame;
+    double          m_PhaseStart[c_PhaseCount];
+};
+
+struct ProfileScope
+{
+    ProfileScope(Profiler& profiler, ProfilePhase phase): m_Profiler(profiler), m_Phase(phase) { m_Profiler.BeginPhase(m_Phase); }
+    ~ProfileScope() { m_Profiler.EndPhase(m_Phase); }
+
+private:
+    Profiler&       m_Profiler;
+    ProfilePhase    m_Phase;
+};
+
 
 struct EditorContext
 {
@@ -1323,6 +1869,11 @@ struct EditorContext
     ImVec2 GetNodePosition(NodeId nodeId);
     ImVec2 GetNodeSize(NodeId nodeId);
 
+    bool IsNodeVisible(NodeId nodeId, float margin);
+    bool GhostNode(NodeId nodeId);
+
+    int AcquireNodeChannels(Node* node);
+
     void SetNodeZPosition(NodeId nodeId, float z);
     float GetNodeZPosition(NodeId nodeId);
 
@@ -1347,6 +1898,11 @@ struct EditorContext
     void FindNodesInRect(const ImRect& r, vector<Node*>& result, bool append = false, bool includeIntersecting = true);
     void FindLinksInRect(const ImRect& r, vector<Link*>& result, bool append = false);
 
+    // Region queries go through a spatial grid, these have to be called
+    // whenever bounds of a node or link change.
+    void NotifyNodeBoundsChanged(Node* node);
+    void NotifyLinkBoundsChanged(Link* link);
+
     bool HasAnyLinks(NodeId nodeId) const;
     bool HasAnyLinks(PinId pinId) const;
 
@@ -1440,6 +1996,9 @@ struct EditorContext
     void RegisterAnimation(Animation* animation);
     void UnregisterAnimation(Animation* animation);
 
+    bool NeedsFrame() const;
+    float GetSettingsSaveTimeout() const;
+
     void Flow(Link* link, FlowDirection direction);
 
     void SetUserContext(bool globalSpace = false);
@@ -1473,6 +2032,8 @@ struct EditorContext
 
     ImDrawList* GetDrawList() { return m_DrawList; }
 
+    Profiler& GetProfiler() { return m_Profiler; }
+
 private:
     void LoadSettings();
     void SaveSettings();
@@ -1483,6 +2044,10 @@ private:
 
     void UpdateAnimations();
 
+    void UpdateNodeOrder();
+    void UpdateLinkOrder();
+    void UpdateLinkBounds();
+
     Config              m_Config;
 
     ImGuiID             m_EditorActiveId;
@@ -1495,9 +2060,17 @@ private:
 
     Style               m_Style;
 
-    vector<ObjectWrapper<Node>> m_Nodes;
+    vector<ObjectWrapper<Node>> m_Nodes;     // in z order
     vector<ObjectWrapper<Pin>>  m_Pins;
-    vector<ObjectWrapper<Link>> m_Links;
+    vector<ObjectWrapper<Link>> m_Links;     // by id, see UpdateLinkOrder()
+    IdMap<Node*>                m_NodeIndex;
+    IdMap<Pin*>                 m_PinIndex;
+    IdMap<Link*>                m_LinkIndex;
+    bool                        m_IsLinkOrderDirty;
+    vector<Link*>               m_DirtyLinks;       // bounds pending, see UpdateLinkBounds()
+
+    SpatialGrid<Node>   m_NodeGrid;
+    SpatialGrid<Link>   m_LinkGrid;
 
     vector<Object*>     m_SelectedObjects;
 
@@ -1505,12 +2078,24 @@ private:
     uint64_t            m_SelectionId;
 
     Link*               m_LastActiveLink;
+    NodeId              m_ActiveControlNode;    // owner of the item active in BuildControl
+    vector<Node*>       m_ControlNodes;
 
     vector<Animation*>  m_LiveAnimations;
     vector<Animation*>  m_LastLiveAnimations;
 
     ImGuiEx::Canvas     m_Canvas;
     bool                m_IsCanvasVisible;
+    bool                m_IsNodeOrderDirty;     // m_Nodes may be out of z order
+
+    struct NodeChannelBand
+    {
+        float   m_ZPosition;
+        bool    m_IsGroup;
+        int     m_Channel;
+    };
+
+    vector<NodeChannelBand> m_NodeChannelBands; // see Config::EnableLayeredNodeChannels
 
     NodeBuilder         m_NodeBuilder;
     HintBuilder         m_HintBuilder;
@@ -1539,10 +2124,15 @@ private:
 
     bool                m_IsInitialized;
     Settings            m_Settings;
+    double              m_SettingsChangeTime;       // see Config::SettingsSaveDelay
+    double              m_SettingsFirstChangeTime;  // first change since last save, negative if there is none
+    SettingsWriter      m_SettingsWriter;
 
     ImDrawList*         m_DrawList;
     int                 m_ExternalChannel;
     ImDrawListSplitter  m_Splitter;
+
+    Profiler            m_Profiler;
 };
 
 
@@ -36,7 +36,9 @@ target_include_directories(imgui_node_editor PUBLIC
     ${IMGUI_NODE_EDITOR_ROOT_DIR}
 )
 
-target_link_libraries(imgui_node_editor PUBLIC imgui)
+find_package(Threads REQUIRED)
+
+target_link_libraries(imgui_node_editor PUBLIC imgui Threads::Threads)
 
 source_group(TREE ${IMGUI_NODE_EDITOR_ROOT_DIR} FILES ${_imgui_node_editor_Sources})
 